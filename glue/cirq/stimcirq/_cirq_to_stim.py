@@ -100,6 +100,15 @@ def cirq_circuit_to_stim_data(
     """Converts a Cirq circuit into a Stim circuit and also metadata about where measurements go."""
     if q2i is None:
         q2i = {q: i for i, q in enumerate(sorted(circuit.all_qubits()))}
+    return _c2s_circuit(circuit, q2i, None, None)
+
+
+def _c2s_circuit(
+    circuit: cirq.Circuit,
+    q2i: Dict[cirq.Qid, int],
+    noise_slots: Optional[List['NoiseSlot']],
+    param_resolver: cirq.ParamResolverOrSimilarType,
+) -> Tuple[stim.Circuit, List[Tuple[str, int]]]:
     out = stim.Circuit()
     key_out: List[Tuple[str, int]] = []
 
@@ -112,11 +121,99 @@ def cirq_circuit_to_stim_data(
             out.append_operation("QUBIT_COORDS", [q2i[q]], [q.row, q.col])
 
     for moment in circuit:
-        _c2s_helper(moment, q2i, out, key_out)
+        _c2s_helper(moment, q2i, out, key_out, noise_slots, param_resolver)
         out.append_operation("TICK", [])
     return out, key_out
 
 
+class UnsupportedParametrizationError(Exception):
+    """Raised when the structure of a converted circuit depends on its parameters, instead of only its noise."""
+
+
+class NoiseSlot:
+    """A parametrized cirq operation that converts into stim instructions that only take noise probabilities.
+
+    The stim instructions for the operation have the same names and targets for every parameter resolution, so only
+    their parens arguments need to be recomputed when the parameters change.
+    """
+
+    def __init__(self, op: cirq.Operation, instruction_indices: List[int], structure: List[Tuple[str, list]]):
+        self.op = op
+        self.instruction_indices = instruction_indices
+        self.structure = structure
+
+    def resolved_args(
+        self, q2i: Dict[cirq.Qid, int], param_resolver: cirq.ParamResolverOrSimilarType
+    ) -> List[List[float]]:
+        """Returns the parens arguments of each of the slot's stim instructions, under the given parameters."""
+        instructions = _resolved_stim_instructions(self.op, q2i, param_resolver)
+        if [(e.name, e.targets_copy()) for e in instructions] != self.structure:
+            raise UnsupportedParametrizationError(f"The stim instructions for {self.op!r} depend on its parameters.")
+        return [e.gate_args_copy() for e in instructions]
+
+
+def cirq_circuit_to_parametrized_stim_data(
+    circuit: cirq.Circuit,
+    *,
+    param_resolver: cirq.ParamResolverOrSimilarType,
+    q2i: Optional[Dict[cirq.Qid, int]] = None,
+) -> Tuple[stim.Circuit, List[Tuple[str, int]], List[NoiseSlot], Dict[cirq.Qid, int]]:
+    """Converts a parametrized Cirq circuit into a Stim circuit with slots for its parametrized noise probabilities.
+
+    The given resolver is only used to determine the structure of parametrized operations. The noise probabilities of
+    the returned circuit are placeholders, which must be overwritten (e.g. via
+    `stim.CompiledMeasurementSampler.set_noise_args`) with the values from `NoiseSlot.resolved_args`.
+
+    Raises:
+        UnsupportedParametrizationError: A parametrized operation converts into instructions that aren't noise, such
+            as a parametrized rotation or a measurement.
+    """
+    if q2i is None:
+        q2i = {q: i for i, q in enumerate(sorted(circuit.all_qubits()))}
+    noise_slots: List[NoiseSlot] = []
+    out, key_out = _c2s_circuit(circuit, q2i, noise_slots, param_resolver)
+
+    # Catch later instructions that happened to fuse into a slot's instruction.
+    for slot in noise_slots:
+        for index, (_, targets) in zip(slot.instruction_indices, slot.structure):
+            if out[index].targets_copy() != targets:
+                raise UnsupportedParametrizationError(f"The stim instructions for {slot.op!r} were merged.")
+
+    return out, key_out, noise_slots, q2i
+
+
+def _resolved_stim_instructions(
+    op: cirq.Operation, q2i: Dict[cirq.Qid, int], param_resolver: cirq.ParamResolverOrSimilarType
+) -> List[stim.CircuitInstruction]:
+    scratch = stim.Circuit()
+    scratch_keys: List[Tuple[str, int]] = []
+    _c2s_helper([cirq.resolve_parameters(op, param_resolver)], q2i, scratch, scratch_keys)
+    instructions = list(scratch)
+    if scratch_keys or not all(isinstance(e, stim.CircuitInstruction) and e.gate_args_copy() for e in instructions):
+        raise UnsupportedParametrizationError(f"{op!r} has parameters that aren't noise probabilities.")
+    return instructions
+
+
+def _append_noise_slot(
+    op: cirq.Operation,
+    q2i: Dict[cirq.Qid, int],
+    out: stim.Circuit,
+    noise_slots: List['NoiseSlot'],
+    param_resolver: cirq.ParamResolverOrSimilarType,
+):
+    instructions = _resolved_stim_instructions(op, q2i, param_resolver)
+    indices = []
+    for e in instructions:
+        index = len(out)
+        # Use distinct placeholder probabilities, so the instruction isn't fused with its neighbors.
+        placeholder = (index + 1) * 2**-64
+        out.append_operation(e.name, e.targets_copy(), [placeholder] * len(e.gate_args_copy()))
+        if len(out) != index + 1:
+            raise UnsupportedParametrizationError(f"The stim instructions for {op!r} were merged.")
+        indices.append(index)
+    noise_slots.append(NoiseSlot(op, indices, [(e.name, e.targets_copy()) for e in instructions]))
+
+
 StimTypeHandler = Callable[[stim.Circuit, cirq.Gate, List[int]], None]
 
 
@@ -316,7 +413,9 @@ def _stim_append_random_gate_channel(c: stim.Circuit, g: cirq.RandomGateChannel,
 
 def _c2s_helper(
     operations: Iterable[cirq.Operation], q2i: Dict[cirq.Qid, int], out: stim.Circuit,
-    key_out: List[Tuple[str, int]]
+    key_out: List[Tuple[str, int]],
+    noise_slots: Optional[List[NoiseSlot]] = None,
+    param_resolver: cirq.ParamResolverOrSimilarType = None,
 ):
     g2f = gate_to_stim_append_func()
     t2f = gate_type_to_stim_append_func()
@@ -324,6 +423,11 @@ def _c2s_helper(
         gate = op.gate
         targets = [q2i[q] for q in op.qubits]
 
+        # Leave slots for noise probabilities that depend on parameters.
+        if noise_slots is not None and cirq.is_parameterized(op):
+            _append_noise_slot(op, q2i, out, noise_slots, param_resolver)
+            continue
+
         custom_method = getattr(op, '_stim_conversion_', getattr(gate, '_stim_conversion_', None))
         if custom_method is not None:
             custom_method(
@@ -353,7 +457,7 @@ def _c2s_helper(
 
         # Ask unrecognized operations to decompose themselves into simpler operations.
         try:
-            _c2s_helper(cirq.decompose_once(op), q2i, out, key_out)
+            _c2s_helper(cirq.decompose_once(op), q2i, out, key_out, noise_slots, param_resolver)
         except TypeError as ex:
             raise TypeError(f"Don't know how to translate {op!r} into stim gates.") from ex
 
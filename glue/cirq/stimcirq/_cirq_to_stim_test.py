@@ -4,11 +4,14 @@ import cirq
 import numpy as np
 import pytest
 import stim
+import sympy
 
 import stimcirq
 from stimcirq._cirq_to_stim import (
+    cirq_circuit_to_parametrized_stim_data,
     cirq_circuit_to_stim_data,
     gate_to_stim_append_func,
+    UnsupportedParametrizationError,
 )
 
 
@@ -308,3 +311,30 @@ def test_custom_qubit_indexing():
     b = cirq.NamedQubit("b")
     actual = stimcirq.cirq_circuit_to_stim_circuit(cirq.Circuit(cirq.CNOT(a, b)), qubit_to_index_dict={a: 10, b: 15})
     assert actual == stim.Circuit('CX 10 15\nTICK')
+
+
+def test_cirq_circuit_to_parametrized_stim_data():
+    a, b = cirq.LineQubit.range(2)
+    p = sympy.Symbol('p')
+    circuit = cirq.Circuit(
+        cirq.Moment(cirq.H(a), cirq.X(b).with_probability(p)),
+        cirq.Moment(cirq.depolarize(0.25).on(a), cirq.X(a).with_probability(2 * p)),
+        cirq.Moment(cirq.measure(a, b, key='m')),
+    )
+    stim_circuit, key_ranges, slots, q2i = cirq_circuit_to_parametrized_stim_data(
+        circuit, param_resolver={'p': 0.125})
+    assert key_ranges == [('m', 2)]
+    assert q2i == {a: 0, b: 1}
+    assert [slot.instruction_indices for slot in slots] == [[1], [4]]
+    assert [stim_circuit[k].name for k in [1, 4]] == ['X_ERROR', 'X_ERROR']
+    assert slots[0].resolved_args(q2i, {'p': 0.25}) == [[0.25]]
+    assert slots[1].resolved_args(q2i, {'p': 0.25}) == [[0.5]]
+
+    sampler = stim_circuit.compile_sampler()
+    sampler.set_noise_args(1, [1])
+    sampler.set_noise_args(4, [0])
+    np.testing.assert_array_equal(sampler.sample(3)[:, 1], [1, 1, 1])
+
+    with pytest.raises(UnsupportedParametrizationError):
+        cirq_circuit_to_parametrized_stim_data(
+            cirq.Circuit(cirq.X(a) ** sympy.Symbol('t')), param_resolver={'t': 1})
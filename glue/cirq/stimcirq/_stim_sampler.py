@@ -1,8 +1,14 @@
-from typing import List
+from typing import List, Optional
 
 import cirq
+import numpy as np
+import stim
 
-from ._cirq_to_stim import cirq_circuit_to_stim_data
+from ._cirq_to_stim import (
+    cirq_circuit_to_parametrized_stim_data,
+    cirq_circuit_to_stim_data,
+    UnsupportedParametrizationError,
+)
 
 
 class StimSampler(cirq.Sampler):
@@ -14,6 +20,10 @@ class StimSampler(cirq.Sampler):
 
     Note that batch sampling is significantly faster (as in potentially thousands of times faster) than individual
     sampling, because it amortizes the cost of parsing and analyzing the circuit.
+
+    When sweeping, the circuit is converted and analyzed once for the whole sweep as long as its parameters only
+    determine noise probabilities (e.g. `cirq.depolarize(sympy.Symbol('p'))`). Otherwise each point of the sweep is
+    converted separately.
     """
 
     def run_sweep(
@@ -23,11 +33,28 @@ class StimSampler(cirq.Sampler):
         repetitions: int = 1,
     ) -> List[cirq.Result]:
         trial_results: List[cirq.Result] = []
+        sweep_sampler: Optional[_SweepSampler] = None
+        tried_sweep_sampler = False
         for param_resolver in cirq.to_resolvers(params):
+            if not tried_sweep_sampler:
+                tried_sweep_sampler = True
+                try:
+                    sweep_sampler = _SweepSampler(program, param_resolver)
+                except UnsupportedParametrizationError:
+                    pass
+
             # Request samples from stim.
-            instance = cirq.resolve_parameters(program, param_resolver)
-            converted_circuit, key_ranges = cirq_circuit_to_stim_data(instance)
-            samples = converted_circuit.compile_sampler().sample(repetitions)
+            samples = None
+            if sweep_sampler is not None:
+                try:
+                    samples = sweep_sampler.sample(param_resolver, repetitions)
+                    key_ranges = sweep_sampler.key_ranges
+                except (UnsupportedParametrizationError, ValueError):
+                    pass
+            if samples is None:
+                instance = cirq.resolve_parameters(program, param_resolver)
+                converted_circuit, key_ranges = cirq_circuit_to_stim_data(instance)
+                samples = converted_circuit.compile_sampler().sample(repetitions)
 
             # Convert unlabelled samples into keyed results.
             k = 0
@@ -39,3 +66,19 @@ class StimSampler(cirq.Sampler):
             trial_results.append(cirq.Result(params=param_resolver, measurements=measurements))
 
         return trial_results
+
+
+class _SweepSampler:
+    """A compiled stim sampler for a cirq circuit, whose parametrized noise probabilities are rebound per sample."""
+
+    def __init__(self, program: cirq.Circuit, param_resolver: cirq.ParamResolverOrSimilarType):
+        circuit, self.key_ranges, self.noise_slots, self.q2i = cirq_circuit_to_parametrized_stim_data(
+            program, param_resolver=param_resolver
+        )
+        self.sampler: stim.CompiledMeasurementSampler = circuit.compile_sampler()
+
+    def sample(self, param_resolver: cirq.ParamResolverOrSimilarType, repetitions: int) -> np.ndarray:
+        for slot in self.noise_slots:
+            for index, args in zip(slot.instruction_indices, slot.resolved_args(self.q2i, param_resolver)):
+                self.sampler.set_noise_args(index, args)
+        return self.sampler.sample(repetitions)
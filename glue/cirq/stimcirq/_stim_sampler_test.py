@@ -1,6 +1,7 @@
 import cirq
 import numpy as np
 import pytest
+import sympy
 
 import stimcirq
 
@@ -100,3 +101,45 @@ def test_correlated_error():
     s = stimcirq.StimSampler()
     a, b = cirq.LineQubit.range(2)
     s.run(cirq.Circuit((cirq.X(a) * cirq.Y(b)).with_probability(0.1)))
+
+
+def test_run_sweep_over_noise_parameters():
+    a, b = cirq.LineQubit.range(2)
+    p = sympy.Symbol('p')
+    q = sympy.Symbol('q')
+    circuit = cirq.Circuit(
+        cirq.X(a),
+        cirq.X(a).with_probability(p),
+        cirq.X(b).with_probability(q),
+        cirq.X(b).with_probability(1 - q),
+        cirq.measure(a, key='a'),
+        cirq.measure(b, key='b'),
+    )
+    results = stimcirq.StimSampler().run_sweep(
+        circuit,
+        cirq.Zip(cirq.Points('p', [0, 1, 0]), cirq.Points('q', [0, 1, 1])),
+        repetitions=10,
+    )
+    assert [r.params['p'] for r in results] == [0, 1, 0]
+    np.testing.assert_array_equal(results[0].measurements['a'], [[1]] * 10)
+    np.testing.assert_array_equal(results[1].measurements['a'], [[0]] * 10)
+    np.testing.assert_array_equal(results[2].measurements['a'], [[1]] * 10)
+    for r in results:
+        np.testing.assert_array_equal(r.measurements['b'], [[1]] * 10)
+
+
+def test_run_sweep_over_structural_parameters():
+    a = cirq.LineQubit(0)
+    t = sympy.Symbol('t')
+    circuit = cirq.Circuit(cirq.X(a) ** t, cirq.measure(a, key='a'))
+    results = stimcirq.StimSampler().run_sweep(circuit, cirq.Points('t', [0, 1, 0, 1]), repetitions=3)
+    for r, expected in zip(results, [0, 1, 0, 1]):
+        np.testing.assert_array_equal(r.measurements['a'], [[expected]] * 3)
+
+
+def test_run_sweep_invalid_noise_parameter():
+    a = cirq.LineQubit(0)
+    p = sympy.Symbol('p')
+    circuit = cirq.Circuit(cirq.X(a).with_probability(p), cirq.measure(a, key='a'))
+    with pytest.raises(ValueError):
+        stimcirq.StimSampler().run_sweep(circuit, cirq.Points('p', [0, 2]))
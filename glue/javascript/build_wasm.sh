@@ -1,6 +1,29 @@
 #!/bin/bash
 set -e
 
+# Usage: build_wasm.sh [--no_simd] [--threads]
+#
+#   --no_simd: Don't use WebAssembly SIMD128 instructions (for engines that don't support them).
+#   --threads: Build with pthreads support. The page hosting the module must be cross-origin isolated.
+simd_flags=(-msimd128)
+thread_flags=()
+for arg in "$@"; do
+    case "${arg}" in
+        --no_simd)
+            simd_flags=()
+            ;;
+        --threads)
+            # Stim starts at most 3 worker threads at once (when transposing large tableaus), and they have to be
+            # created ahead of time because the browser's main thread can't block while waiting for a new worker.
+            thread_flags=(-pthread -s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=3)
+            ;;
+        *)
+            echo "Unrecognized argument: ${arg}" >&2
+            exit 1
+            ;;
+    esac
+done
+
 # Get to this script's git repo root.
 cd "$( dirname "${BASH_SOURCE[0]}" )"
 cd "$(git rev-parse --show-toplevel)"
@@ -29,6 +52,10 @@ echo '</script>' >> out/all_stim_tests.html
 
 # Build web assembly module using emscripten.
 emcc \
+    -O3 \
+    "${simd_flags[@]}" \
+    "${thread_flags[@]}" \
+    -s ALLOW_MEMORY_GROWTH=1 \
     -s NO_DISABLE_EXCEPTION_CATCHING \
     -s EXPORT_NAME="load_stim_module"  \
     -s MODULARIZE=1  \
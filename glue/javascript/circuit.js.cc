@@ -3,6 +3,8 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 
+#include "../../src/simulators/error_analyzer.h"
+
 using namespace stim_internal;
 
 ExposedCircuit::ExposedCircuit() : circuit() {
@@ -42,6 +44,21 @@ bool ExposedCircuit::isEqualTo(const ExposedCircuit &other) const {
     return circuit == other.circuit;
 }
 
+emscripten::val ExposedCircuit::sampleDetectors(size_t numShots, bool appendObservables) const {
+    ExposedCompiledDetectorSampler sampler(circuit);
+    // The view points into the temporary sampler's buffer, so it's copied into a new array in one call.
+    return emscripten::val::global("Uint8Array").new_(sampler.sampleBitPacked(numShots, appendObservables));
+}
+
+ExposedCompiledDetectorSampler ExposedCircuit::compileDetectorSampler() const {
+    return ExposedCompiledDetectorSampler(circuit);
+}
+
+ExposedDetectorErrorModel ExposedCircuit::detectorErrorModel(bool decomposeErrors) const {
+    return ExposedDetectorErrorModel(
+        ErrorAnalyzer::circuit_to_detector_error_model(circuit, decomposeErrors, true, false, 0));
+}
+
 void emscripten_bind_circuit() {
     auto &&c = emscripten::class_<ExposedCircuit>("Circuit");
     c.constructor();
@@ -52,4 +69,7 @@ void emscripten_bind_circuit() {
     c.function("append_operation", &ExposedCircuit::append_operation);
     c.function("append_from_stim_program_text", &ExposedCircuit::append_from_stim_program_text);
     c.function("isEqualTo", &ExposedCircuit::isEqualTo);
+    c.function("sampleDetectors", &ExposedCircuit::sampleDetectors);
+    c.function("compileDetectorSampler", &ExposedCircuit::compileDetectorSampler);
+    c.function("detectorErrorModel", &ExposedCircuit::detectorErrorModel);
 }
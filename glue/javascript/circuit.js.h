@@ -6,6 +6,8 @@
 #include <emscripten/val.h>
 
 #include "../../src/circuit/circuit.h"
+#include "compiled_detector_sampler.js.h"
+#include "detector_error_model.js.h"
 
 struct ExposedCircuit {
     stim_internal::Circuit circuit;
@@ -18,6 +20,9 @@ struct ExposedCircuit {
     ExposedCircuit copy() const;
     bool isEqualTo(const ExposedCircuit &other) const;
     std::string toString() const;
+    emscripten::val sampleDetectors(size_t numShots, bool appendObservables) const;
+    ExposedCompiledDetectorSampler compileDetectorSampler() const;
+    ExposedDetectorErrorModel detectorErrorModel(bool decomposeErrors) const;
 };
 
 void emscripten_bind_circuit();
@@ -63,3 +63,22 @@ test("circuit.isEqualTo", ({stim, assert}) => {
         }
     `)));
 });
+
+test("circuit.sampleDetectors", ({stim, assert}) => {
+    let c = new stim.Circuit(`
+        X_ERROR(1) 0
+        M 0 1
+        DETECTOR rec[-2]
+        DETECTOR rec[-1]
+        OBSERVABLE_INCLUDE(0) rec[-2]
+    `);
+    let shots = c.sampleDetectors(3, false);
+    assert(shots instanceof Uint8Array);
+    assert(shots.length === 3);
+    for (let shot of shots) {
+        assert(shot === 0b01);
+    }
+    let with_obs = c.sampleDetectors(2, true);
+    assert(with_obs.length === 2);
+    assert(with_obs[1] === 0b101);
+});
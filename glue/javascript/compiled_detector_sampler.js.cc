@@ -0,0 +1,41 @@
+#include "compiled_detector_sampler.js.h"
+
+#include <cstring>
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include "../../src/simulators/detection_simulator.h"
+#include "common.js.h"
+
+using namespace stim_internal;
+
+ExposedCompiledDetectorSampler::ExposedCompiledDetectorSampler(Circuit circuit)
+    : circuit(std::move(circuit)), program(this->circuit), buffer() {
+}
+
+size_t ExposedCompiledDetectorSampler::numDetectors() const {
+    return program.num_detectors;
+}
+
+size_t ExposedCompiledDetectorSampler::numObservables() const {
+    return program.num_observables;
+}
+
+emscripten::val ExposedCompiledDetectorSampler::sampleBitPacked(size_t numShots, bool appendObservables) {
+    size_t num_results = program.num_detectors + (appendObservables ? program.num_observables : 0);
+    size_t bytes_per_shot = (num_results + 7) >> 3;
+    auto table = detector_samples(circuit, program, numShots, false, appendObservables, JS_BIND_SHARED_RNG());
+    auto shot_major = table.transposed();
+    buffer.resize(numShots * bytes_per_shot);
+    for (size_t shot = 0; shot < numShots; shot++) {
+        memcpy(buffer.data() + shot * bytes_per_shot, shot_major[shot].u8, bytes_per_shot);
+    }
+    return emscripten::val(emscripten::typed_memory_view(buffer.size(), buffer.data()));
+}
+
+void emscripten_bind_compiled_detector_sampler() {
+    auto &&c = emscripten::class_<ExposedCompiledDetectorSampler>("CompiledDetectorSampler");
+    c.function("numDetectors", &ExposedCompiledDetectorSampler::numDetectors);
+    c.function("numObservables", &ExposedCompiledDetectorSampler::numObservables);
+    c.function("sampleBitPacked", &ExposedCompiledDetectorSampler::sampleBitPacked);
+}
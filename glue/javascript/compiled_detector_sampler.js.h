@@ -0,0 +1,24 @@
+#ifndef STIM_COMPILED_DETECTOR_SAMPLER_JS_H
+#define STIM_COMPILED_DETECTOR_SAMPLER_JS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <emscripten/val.h>
+
+#include "../../src/circuit/circuit.h"
+#include "../../src/simulators/detector_xor_program.h"
+
+struct ExposedCompiledDetectorSampler {
+    stim_internal::Circuit circuit;
+    stim_internal::DetectorXorProgram program;
+    /// Backing storage for the most recent samples. Handed to javascript as a view, not a copy.
+    std::vector<uint8_t> buffer;
+    explicit ExposedCompiledDetectorSampler(stim_internal::Circuit circuit);
+    size_t numDetectors() const;
+    size_t numObservables() const;
+    emscripten::val sampleBitPacked(size_t numShots, bool appendObservables);
+};
+
+void emscripten_bind_compiled_detector_sampler();
+
+#endif
@@ -0,0 +1,47 @@
+test("compiled_detector_sampler.sampleBitPacked", ({stim, assert}) => {
+    let c = new stim.Circuit(`
+        X_ERROR(1) 0 2
+        M 0 1 2
+        DETECTOR rec[-3]
+        DETECTOR rec[-2]
+        OBSERVABLE_INCLUDE(0) rec[-1]
+    `);
+    let sampler = c.compileDetectorSampler();
+    assert(sampler.numDetectors() === 2);
+    assert(sampler.numObservables() === 1);
+
+    let samples = sampler.sampleBitPacked(5, false);
+    assert(samples instanceof Uint8Array);
+    assert(samples.length === 5);
+    for (let k = 0; k < 5; k++) {
+        assert(samples[k] === 0b01);
+    }
+
+    samples = sampler.sampleBitPacked(3, true);
+    assert(samples.length === 3);
+    for (let k = 0; k < 3; k++) {
+        assert(samples[k] === 0b101);
+    }
+});
+
+test("compiled_detector_sampler.sampleBitPacked_multiple_bytes", ({stim, assert}) => {
+    let c = new stim.Circuit(`
+        X_ERROR(1) 9
+        M 0 1 2 3 4 5 6 7 8 9
+        DETECTOR rec[-10]
+        DETECTOR rec[-9]
+        DETECTOR rec[-8]
+        DETECTOR rec[-7]
+        DETECTOR rec[-6]
+        DETECTOR rec[-5]
+        DETECTOR rec[-4]
+        DETECTOR rec[-3]
+        DETECTOR rec[-2]
+        DETECTOR rec[-1]
+    `);
+    let sampler = c.compileDetectorSampler();
+    let samples = sampler.sampleBitPacked(2, false);
+    assert(samples.length === 4);
+    assert(samples[0] === 0 && samples[1] === 2);
+    assert(samples[2] === 0 && samples[3] === 2);
+});
@@ -0,0 +1,83 @@
+#include "detector_error_model.js.h"
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+using namespace stim_internal;
+
+/// Observable ids are marked with the top bit when stored into a Uint32Array.
+constexpr uint32_t JS_OBSERVABLE_BIT = uint32_t{1} << 31;
+/// Separators are stored into a Uint32Array as the maximum value.
+constexpr uint32_t JS_SEPARATOR = UINT32_MAX;
+
+static void append_flattened_errors(
+    const DetectorErrorModel &model, uint64_t &detector_shift, ExposedDetectorErrorModel &out) {
+    for (const auto &op : model.instructions) {
+        switch (op.type) {
+            case DEM_REPEAT_BLOCK: {
+                const auto &block = model.blocks[op.target_data[1].data];
+                for (uint64_t k = 0; k < op.target_data[0].data; k++) {
+                    append_flattened_errors(block, detector_shift, out);
+                }
+                break;
+            }
+            case DEM_SHIFT_DETECTORS:
+                detector_shift += op.target_data[0].data;
+                break;
+            case DEM_ERROR:
+                out.error_probabilities.push_back(op.arg_data[0]);
+                for (auto t : op.target_data) {
+                    if (t.is_separator()) {
+                        out.error_targets.push_back(JS_SEPARATOR);
+                    } else if (t.is_observable_id()) {
+                        // The largest id would be marked as JS_SEPARATOR.
+                        if (t.raw_id() >= JS_OBSERVABLE_BIT - 1) {
+                            throw std::out_of_range("Observable id is too large for a Uint32Array.");
+                        }
+                        out.error_targets.push_back((uint32_t)t.raw_id() | JS_OBSERVABLE_BIT);
+                    } else {
+                        // Detectors must stay clear of JS_OBSERVABLE_BIT, which also keeps them clear of JS_SEPARATOR.
+                        uint64_t d = t.raw_id() + detector_shift;
+                        if (d >= JS_OBSERVABLE_BIT) {
+                            throw std::out_of_range("Detector id is too large for a Uint32Array.");
+                        }
+                        out.error_targets.push_back((uint32_t)d);
+                    }
+                }
+                out.error_target_offsets.push_back(out.error_targets.size());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+ExposedDetectorErrorModel::ExposedDetectorErrorModel(DetectorErrorModel model)
+    : model(std::move(model)), error_probabilities(), error_target_offsets{0}, error_targets() {
+    uint64_t detector_shift = 0;
+    append_flattened_errors(this->model, detector_shift, *this);
+}
+
+std::string ExposedDetectorErrorModel::toString() const {
+    return model.str();
+}
+
+emscripten::val ExposedDetectorErrorModel::errorProbabilities() const {
+    return emscripten::val(emscripten::typed_memory_view(error_probabilities.size(), error_probabilities.data()));
+}
+
+emscripten::val ExposedDetectorErrorModel::errorTargetOffsets() const {
+    return emscripten::val(emscripten::typed_memory_view(error_target_offsets.size(), error_target_offsets.data()));
+}
+
+emscripten::val ExposedDetectorErrorModel::errorTargets() const {
+    return emscripten::val(emscripten::typed_memory_view(error_targets.size(), error_targets.data()));
+}
+
+void emscripten_bind_detector_error_model() {
+    auto &&c = emscripten::class_<ExposedDetectorErrorModel>("DetectorErrorModel");
+    c.function("toString", &ExposedDetectorErrorModel::toString);
+    c.function("errorProbabilities", &ExposedDetectorErrorModel::errorProbabilities);
+    c.function("errorTargetOffsets", &ExposedDetectorErrorModel::errorTargetOffsets);
+    c.function("errorTargets", &ExposedDetectorErrorModel::errorTargets);
+}
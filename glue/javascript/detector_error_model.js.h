@@ -0,0 +1,25 @@
+#ifndef STIM_DETECTOR_ERROR_MODEL_JS_H
+#define STIM_DETECTOR_ERROR_MODEL_JS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <emscripten/val.h>
+
+#include "../../src/dem/detector_error_model.h"
+
+struct ExposedDetectorErrorModel {
+    stim_internal::DetectorErrorModel model;
+    /// The model's error instructions with loops unrolled, in the layout handed to javascript as views.
+    std::vector<double> error_probabilities;
+    std::vector<uint32_t> error_target_offsets;
+    std::vector<uint32_t> error_targets;
+    explicit ExposedDetectorErrorModel(stim_internal::DetectorErrorModel model);
+    std::string toString() const;
+    emscripten::val errorProbabilities() const;
+    emscripten::val errorTargetOffsets() const;
+    emscripten::val errorTargets() const;
+};
+
+void emscripten_bind_detector_error_model();
+
+#endif
@@ -0,0 +1,46 @@
+test("detector_error_model.toString", ({stim, assert}) => {
+    let c = new stim.Circuit(`
+        X_ERROR(0.125) 0
+        M 0
+        DETECTOR rec[-1]
+    `);
+    let model = c.detectorErrorModel(false);
+    assert(model.toString().trim() === `
+error(0.125) D0
+    `.trim());
+});
+
+test("detector_error_model.error_arrays", ({stim, assert}) => {
+    let c = new stim.Circuit(`
+        X_ERROR(0.25) 0
+        M 0
+        OBSERVABLE_INCLUDE(0) rec[-1]
+        REPEAT 3 {
+            X_ERROR(0.125) 0
+            M 0
+            DETECTOR rec[-1] rec[-2]
+        }
+    `);
+    let model = c.detectorErrorModel(false);
+    let probabilities = model.errorProbabilities();
+    let offsets = model.errorTargetOffsets();
+    let targets = model.errorTargets();
+    assert(probabilities instanceof Float64Array);
+    assert(offsets instanceof Uint32Array);
+    assert(targets instanceof Uint32Array);
+    assert(probabilities.length === 4);
+    assert(offsets.length === 5);
+    assert(offsets[0] === 0);
+    let errors = [];
+    for (let k = 0; k < probabilities.length; k++) {
+        let ts = Array.from(targets.subarray(offsets[k], offsets[k + 1]));
+        errors.push(probabilities[k] + ':' + ts.join(' '));
+    }
+    errors.sort();
+    assert(errors.join(',') === [
+        '0.125:0',
+        '0.125:1',
+        '0.125:2',
+        '0.25:' + 2**31,
+    ].join(','));
+});
@@ -2,12 +2,16 @@
 #include <emscripten/val.h>
 
 #include "circuit.js.h"
+#include "compiled_detector_sampler.js.h"
+#include "detector_error_model.js.h"
 #include "pauli_string.js.h"
 #include "tableau.js.h"
 #include "tableau_simulator.js.h"
 
 EMSCRIPTEN_BINDINGS(stim) {
     emscripten_bind_circuit();
+    emscripten_bind_compiled_detector_sampler();
+    emscripten_bind_detector_error_model();
     emscripten_bind_pauli_string();
     emscripten_bind_tableau();
     emscripten_bind_tableau_simulator();
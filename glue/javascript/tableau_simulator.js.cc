@@ -28,7 +28,6 @@ static TempArgData args_to_targets(TableauSimulator &self, const emscripten::val
         max_q = std::max(max_q, q & TARGET_VALUE_MASK);
     }
 
-    // Note: quadratic behavior.
     self.ensure_large_enough_for_qubits((size_t)max_q + 1);
 
     return TempArgData(result);
@@ -82,7 +81,7 @@ emscripten::val ExposedTableauSimulator::measure_kickback(size_t target) {
 void ExposedTableauSimulator::do_circuit(const ExposedCircuit &circuit) {
     sim.ensure_large_enough_for_qubits(circuit.circuit.count_qubits());
     circuit.circuit.for_each_operation([&](const Operation &op) {
-        (sim.*op.gate->tableau_simulator_function)(op.target_data);
+        sim.do_gate(op);
     });
 }
 void ExposedTableauSimulator::do_pauli_string(const ExposedPauliString &pauli_string) {
@@ -32,6 +32,6 @@ setup(
     long_description_content_type='text/markdown',
     python_requires='>=3.6.0',
     data_files=['README.md'],
-    install_requires=['stim', 'networkx'],
+    install_requires=['stim', 'networkx', 'numpy'],
     tests_require=['pytest', 'python3-distutils'],
 )
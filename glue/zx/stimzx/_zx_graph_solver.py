@@ -1,6 +1,7 @@
-from typing import Dict, Tuple, List, Any, Union
-import stim
+from typing import List, Union
 import networkx as nx
+import numpy as np
+import stim
 
 from ._text_diagram_parsing import text_diagram_to_networkx_graph
 from ._external_stabilizer import ExternalStabilizer
@@ -42,6 +43,15 @@ ZX_TYPES = {
     "out": ZxType("out"),
 }
 
+# The node kind codes used by `stim.zx_graph_dual_stabilizers`.
+_NATIVE_NODE_KINDS = {
+    "X": 0,
+    "Z": 1,
+    "H": 2,
+    "in": 3,
+    "out": 4,
+}
+
 
 def text_diagram_to_zx_graph(text_diagram: str) -> nx.MultiGraph:
     """Converts an ASCII text diagram into a ZX graph (represented as a networkx MultiGraph).
@@ -91,21 +101,6 @@ def text_diagram_to_zx_graph(text_diagram: str) -> nx.MultiGraph:
     return text_diagram_to_networkx_graph(text_diagram, value_func=ZX_TYPES.__getitem__)
 
 
-def _reduced_zx_graph(graph: Union[nx.Graph, nx.MultiGraph]) -> nx.Graph:
-    """Return an equivalent graph without self edges or repeated edges."""
-    reduced_graph = nx.Graph()
-    odd_parity_edges = set()
-    for n1, n2 in graph.edges():
-        if n1 == n2:
-            continue
-        odd_parity_edges ^= {frozenset([n1, n2])}
-    for n, value in graph.nodes('value'):
-        reduced_graph.add_node(n, value=value)
-    for n1, n2 in odd_parity_edges:
-        reduced_graph.add_edge(n1, n2)
-    return reduced_graph
-
-
 def zx_graph_to_external_stabilizers(graph: Union[nx.Graph, nx.MultiGraph]) -> List[ExternalStabilizer]:
     """Computes the external stabilizers of a ZX graph; generators of Paulis that leave it unchanged including sign.
 
@@ -120,77 +115,32 @@ def zx_graph_to_external_stabilizers(graph: Union[nx.Graph, nx.MultiGraph]) -> L
         A list of canonicalized external stabilizer generators for the graph.
     """
 
-    graph = _reduced_zx_graph(graph)
-    sim = stim.TableauSimulator()
-
-    # Interpret each edge as a cup producing an EPR pair.
-    # - The qubits of the EPR pair fly away from the center of the edge, towards their respective nodes.
-    # - The qubit keyed by (a, b) is the qubit heading towards b from the edge between a and b.
-    qubit_ids: Dict[Tuple[Any, Any], int] = {}
-    for n1, n2 in graph.edges:
-        qubit_ids[(n1, n2)] = len(qubit_ids)
-        qubit_ids[(n2, n1)] = len(qubit_ids)
-        sim.h(qubit_ids[(n1, n2)])
-        sim.cnot(qubit_ids[(n1, n2)], qubit_ids[(n2, n1)])
-
-    # Interpret each internal node as a family of post-selected parity measurements.
-    for n, node_type in graph.nodes('value'):
-        if node_type.kind in 'XZ':
-            # Surround X type node with Hadamards so it can be handled as if it were Z type.
-            if node_type.kind == 'X':
-                for neighbor in graph.neighbors(n):
-                    sim.h(qubit_ids[(neighbor, n)])
-        elif node_type.kind == 'H':
-            # Hadamard one input so the H node can be handled as if it were Z type.
-            neighbor, _ = graph.neighbors(n)
-            sim.h(qubit_ids[(neighbor, n)])
-        elif node_type.kind in ['out', 'in']:
-            continue  # Don't measure qubits leaving the system.
-        else:
-            raise ValueError(f"Unknown node type {node_type!r}")
-
-        # Handle Z type node.
-        # - Postselects the ZZ observable over each pair of incoming qubits.
-        # - Postselects the (S**quarter_turns X S**-quarter_turns)XX..X observable over all incoming qubits.
-        neighbors = [n2 for n2 in graph.neighbors(n) if n2 != n]
-        center = qubit_ids[(neighbors[0], n)]  # Pick one incoming qubit to be the common control for the others.
-        # Handle node angle using a phasing operation.
-        [id, sim.s, sim.z, sim.s_dag][node_type.quarter_turns](center)
-        # Use multi-target CNOT and Hadamard to transform postselected observables into single-qubit Z observables.
-        for n2 in neighbors[1:]:
-            sim.cnot(center, qubit_ids[(n2, n)])
-        sim.h(center)
-        # Postselect the observables.
-        for n2 in neighbors:
-            _pseudo_postselect(sim, qubit_ids[(n2, n)])
-
-    # Find output qubits.
+    # Number the nodes for the native solver.
+    # - Internal nodes keep the graph's order, so that neighbors tend to have nearby ids.
+    # - External nodes go at the end, sorted, because the solver orders external qubits by node id.
     in_nodes = sorted(n for n, value in graph.nodes('value') if value.kind == 'in')
     out_nodes = sorted(n for n, value in graph.nodes('value') if value.kind == 'out')
-    ext_nodes = in_nodes + out_nodes
-    out_qubits = []
-    for out in ext_nodes:
-        (neighbor,) = graph.neighbors(out)
-        out_qubits.append(qubit_ids[(neighbor, out)])
-
-    # Remove qubits corresponding to non-external edges.
-    for i, q in enumerate(out_qubits):
-        sim.swap(q, len(qubit_ids) + i)
-    for i, q in enumerate(out_qubits):
-        sim.swap(i, len(qubit_ids) + i)
-    sim.set_num_qubits(len(out_qubits))
-
-    # Stabilizers of the simulator state are the external stabilizers of the graph.
-    dual_stabilizers = sim.canonical_stabilizers()
-    return ExternalStabilizer.canonicals_from_duals(dual_stabilizers, len(in_nodes))
+    internal_nodes = [n for n, value in graph.nodes('value') if value.kind not in ['in', 'out']]
+    ordered_nodes = internal_nodes + in_nodes + out_nodes
+    node_ids = {n: k for k, n in enumerate(ordered_nodes)}
+
+    node_kinds = np.empty(len(ordered_nodes), dtype=np.uint8)
+    node_quarter_turns = np.zeros(len(ordered_nodes), dtype=np.uint8)
+    for k, n in enumerate(ordered_nodes):
+        node_type = graph.nodes[n]['value']
+        if node_type.kind not in _NATIVE_NODE_KINDS:
+            raise ValueError(f"Unknown node type {node_type!r}")
+        node_kinds[k] = _NATIVE_NODE_KINDS[node_type.kind]
+        if node_type.kind in 'XZ':
+            node_quarter_turns[k] = node_type.quarter_turns % 4
 
+    edges = np.array([(node_ids[n1], node_ids[n2]) for n1, n2 in graph.edges()], dtype=np.uint64).reshape(-1, 2)
 
-def _pseudo_postselect(sim: stim.TableauSimulator, target: int):
-    """Pretend to postselect by using classical feedback to consistently get into the measurement-was-false state."""
-    measurement_result, kickback = sim.measure_kickback(target)
-    if kickback is not None:
-        for qubit, pauli in enumerate(kickback):
-            feedback_op = [None, sim.cnot, sim.cy, sim.cz][pauli]
-            if feedback_op is not None:
-                feedback_op(stim.target_rec(-1), qubit)
-    assert kickback is not None or not measurement_result, "Impossible postselection. Graph contained a contradiction."
+    # The solver interprets each edge as an EPR pair and each internal node as a family of post-selected parity
+    # measurements, leaving the state whose stabilizers are the external stabilizers of the graph.
+    dual_stabilizers = stim.zx_graph_dual_stabilizers(
+        node_kinds=node_kinds,
+        node_quarter_turns=node_quarter_turns,
+        edges=edges,
+    )
+    return ExternalStabilizer.canonicals_from_duals(dual_stabilizers, len(in_nodes))
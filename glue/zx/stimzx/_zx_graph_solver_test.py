@@ -1,8 +1,10 @@
 from typing import List
 
+import networkx as nx
+import pytest
 import stim
 
-from ._zx_graph_solver import zx_graph_to_external_stabilizers, text_diagram_to_zx_graph, ExternalStabilizer
+from ._zx_graph_solver import zx_graph_to_external_stabilizers, text_diagram_to_zx_graph, ExternalStabilizer, ZxType
 
 
 def test_disconnected():
@@ -122,6 +124,26 @@ def test_s_state_distill():
     """)) == external_stabilizers_of_circuit(stim.Circuit("S 0"))
 
 
+def test_contradiction():
+    with pytest.raises(ValueError, match="contradiction"):
+        zx_graph_to_external_stabilizers(text_diagram_to_zx_graph("""
+            in---Z---out
+
+            Z(pi)---Z
+        """))
+
+
+def test_long_chain():
+    graph = nx.MultiGraph()
+    graph.add_node(0, value=ZxType("in"))
+    for k in range(1, 5001):
+        graph.add_node(k, value=ZxType("XZ"[k % 2]))
+        graph.add_edge(k - 1, k)
+    graph.add_node(5001, value=ZxType("out"))
+    graph.add_edge(5000, 5001)
+    assert zx_graph_to_external_stabilizers(graph) == external_stabilizers_of_circuit(stim.Circuit("I 0"))
+
+
 def external_stabilizers_of_circuit(circuit: stim.Circuit) -> List[ExternalStabilizer]:
     n = circuit.num_qubits
     s = stim.TableauSimulator()
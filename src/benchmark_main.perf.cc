@@ -13,11 +13,16 @@
 // limitations under the License.
 
 #include <cmath>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <thread>
 
 #include "arg_parse.h"
 #include "benchmark_util.h"
+#include "simd/simd_compat.h"
 
 using namespace stim_internal;
 
@@ -76,7 +81,33 @@ std::string si2(double val) {
     return ss.str();
 }
 
-static std::vector<const char *> known_arguments{"--only", "--target_seconds"};
+static std::vector<const char *> known_arguments{
+    "--only",
+    "--target_seconds",
+    "--trials",
+    "--format",
+    "--out",
+    "--baseline",
+    "--regression_threshold",
+};
+
+enum BenchmarkOutputFormat {
+    BENCHMARK_OUTPUT_TEXT,
+    BENCHMARK_OUTPUT_JSON,
+    BENCHMARK_OUTPUT_CSV,
+};
+
+static std::map<std::string, BenchmarkOutputFormat> format_name_to_enum_map{
+    {"text", BENCHMARK_OUTPUT_TEXT},
+    {"json", BENCHMARK_OUTPUT_JSON},
+    {"csv", BENCHMARK_OUTPUT_CSV},
+};
+
+/// One timed result, flattened out of the benchmark that produced it.
+struct NamedBenchmarkResult {
+    std::string name;
+    const BenchmarkResult *result;
+};
 
 void find_benchmarks(const std::string &filter, std::vector<RegisteredBenchmark> &out) {
     bool found = false;
@@ -108,12 +139,225 @@ void find_benchmarks(const std::string &filter, std::vector<RegisteredBenchmark>
 }
 
 double BENCHMARK_CONFIG_TARGET_SECONDS = 0.5;
+size_t BENCHMARK_CONFIG_TRIALS = 1;
+
+std::string cpu_model_name() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.substr(0, 10) == "model name") {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) {
+                size_t start = line.find_first_not_of(' ', colon + 1);
+                return start == std::string::npos ? "" : line.substr(start);
+            }
+        }
+    }
+    return "unknown";
+}
+
+const char *simd_instruction_set_name() {
+#if __AVX2__
+    return "avx2";
+#elif __SSE2__
+    return "sse2";
+#elif __wasm_simd128__
+    return "simd128";
+#else
+    return "polyfill";
+#endif
+}
+
+std::string json_quoted(const std::string &text) {
+    std::stringstream ss;
+    ss << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            ss << '\\' << c;
+        } else if ((unsigned char)c < 32) {
+            ss << ' ';
+        } else {
+            ss << c;
+        }
+    }
+    ss << '"';
+    return ss.str();
+}
+
+std::vector<std::pair<std::string, std::string>> benchmark_metadata() {
+    std::vector<std::pair<std::string, std::string>> result;
+    result.emplace_back("cpu", cpu_model_name());
+    result.emplace_back("hardware_threads", std::to_string(std::thread::hardware_concurrency()));
+    result.emplace_back("simd_instruction_set", simd_instruction_set_name());
+    result.emplace_back("simd_width_bits", std::to_string(sizeof(simd_word) * 8));
+#ifdef __VERSION__
+    result.emplace_back("compiler", __VERSION__);
+#else
+    result.emplace_back("compiler", "unknown");
+#endif
+    result.emplace_back("target_seconds", std::to_string(BENCHMARK_CONFIG_TARGET_SECONDS));
+    result.emplace_back("trials", std::to_string(BENCHMARK_CONFIG_TRIALS));
+    return result;
+}
+
+void write_text_result(std::ostream &out, const NamedBenchmarkResult &named) {
+    const BenchmarkResult &result = *named.result;
+    double actual_seconds_per_rep = result.median_seconds_per_rep();
+    if (result.goal_seconds != -1) {
+        int deviation = (int)round((log(result.goal_seconds) - log(actual_seconds_per_rep)) / (log(10) / 10.0));
+        out << "[";
+        for (int k = -20; k <= 20; k++) {
+            if ((k < deviation && k < 0) || (k > deviation && k > 0)) {
+                out << '.';
+            } else if (k == deviation) {
+                out << '*';
+            } else if (k == 0) {
+                out << '|';
+            } else if (deviation < 0) {
+                out << '<';
+            } else {
+                out << '>';
+            }
+        }
+        out << "] ";
+        out << si2(actual_seconds_per_rep) << "s";
+        out << " (vs " << si2(result.goal_seconds) << "s) ";
+    } else {
+        out << si2(actual_seconds_per_rep) << "s ";
+    }
+    if (result.trial_seconds_per_rep.size() > 1) {
+        out << "(+-" << si2(result.mad_seconds_per_rep()) << "s) ";
+    }
+    for (const auto &e : result.marginal_rates) {
+        const auto &multiplier = e.second;
+        const auto &unit = e.first;
+        out << "(" << si2(multiplier / actual_seconds_per_rep) << unit << "/s) ";
+    }
+    out << named.name << "\n";
+}
+
+/// Writes one benchmark per line, so that baseline files can be read back without a full json parser.
+void write_json_results(std::ostream &out, const std::vector<NamedBenchmarkResult> &results) {
+    out << std::setprecision(9);
+    out << "{\n";
+    out << "  \"metadata\": {\n";
+    auto metadata = benchmark_metadata();
+    for (size_t k = 0; k < metadata.size(); k++) {
+        out << "    " << json_quoted(metadata[k].first) << ": " << json_quoted(metadata[k].second);
+        out << (k + 1 < metadata.size() ? ",\n" : "\n");
+    }
+    out << "  },\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t k = 0; k < results.size(); k++) {
+        const BenchmarkResult &r = *results[k].result;
+        out << "    {\"name\": " << json_quoted(results[k].name);
+        out << ", \"median_seconds\": " << r.median_seconds_per_rep();
+        out << ", \"mad_seconds\": " << r.mad_seconds_per_rep();
+        out << ", \"goal_seconds\": ";
+        if (r.goal_seconds == -1) {
+            out << "null";
+        } else {
+            out << r.goal_seconds;
+        }
+        out << ", \"total_reps\": " << r.total_reps;
+        out << ", \"trial_seconds\": [";
+        for (size_t t = 0; t < r.trial_seconds_per_rep.size(); t++) {
+            out << (t ? ", " : "") << r.trial_seconds_per_rep[t];
+        }
+        out << "], \"rates_per_second\": {";
+        for (size_t e = 0; e < r.marginal_rates.size(); e++) {
+            out << (e ? ", " : "") << json_quoted(r.marginal_rates[e].first) << ": "
+                << r.marginal_rates[e].second / r.median_seconds_per_rep();
+        }
+        out << "}}";
+        out << (k + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+void write_csv_results(std::ostream &out, const std::vector<NamedBenchmarkResult> &results) {
+    out << std::setprecision(9);
+    for (const auto &e : benchmark_metadata()) {
+        out << "# " << e.first << ": " << e.second << "\n";
+    }
+    out << "name,median_seconds,mad_seconds,goal_seconds,total_reps,trials\n";
+    for (const auto &named : results) {
+        const BenchmarkResult &r = *named.result;
+        out << named.name << "," << r.median_seconds_per_rep() << "," << r.mad_seconds_per_rep() << ",";
+        if (r.goal_seconds != -1) {
+            out << r.goal_seconds;
+        }
+        out << "," << r.total_reps << "," << r.trial_seconds_per_rep.size() << "\n";
+    }
+}
+
+/// Reads the median seconds of each benchmark from a file previously written with `--format=json` or `--format=csv`.
+std::map<std::string, double> read_baseline(const char *path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Failed to open baseline file '" << path << "'.\n";
+        exit(EXIT_FAILURE);
+    }
+    std::map<std::string, double> result;
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t name_key = line.find("\"name\": \"");
+        if (name_key != std::string::npos) {
+            size_t name_start = name_key + 9;
+            size_t name_end = line.find('"', name_start);
+            size_t median_key = line.find("\"median_seconds\": ");
+            if (name_end == std::string::npos || median_key == std::string::npos) {
+                continue;
+            }
+            result[line.substr(name_start, name_end - name_start)] = atof(line.c_str() + median_key + 18);
+        } else if (!line.empty() && line[0] != '#' && line[0] != '{' && line[0] != ' ' && line[0] != '}' &&
+                   line.substr(0, 5) != "name,") {
+            size_t comma = line.find(',');
+            if (comma != std::string::npos) {
+                result[line.substr(0, comma)] = atof(line.c_str() + comma + 1);
+            }
+        }
+    }
+    return result;
+}
+
+/// Prints a comparison against the baseline to stderr and returns the number of regressions.
+size_t compare_to_baseline(
+    const std::vector<NamedBenchmarkResult> &results,
+    const std::map<std::string, double> &baseline,
+    double regression_threshold) {
+    size_t regressions = 0;
+    for (const auto &named : results) {
+        auto found = baseline.find(named.name);
+        if (found == baseline.end() || found->second <= 0) {
+            std::cerr << "[new]        " << named.name << "\n";
+            continue;
+        }
+        double ratio = named.result->median_seconds_per_rep() / found->second;
+        bool regressed = ratio > 1 + regression_threshold;
+        regressions += regressed;
+        std::cerr << (regressed ? "[REGRESSED]  " : (ratio < 1 / (1 + regression_threshold) ? "[improved]   " : "[ok]         "));
+        std::cerr << std::setprecision(3) << ratio << "x " << si2(named.result->median_seconds_per_rep()) << "s (vs "
+                  << si2(found->second) << "s) " << named.name << "\n";
+    }
+    return regressions;
+}
 
 int main(int argc, const char **argv) {
     check_for_unknown_arguments(known_arguments, nullptr, argc, argv);
     const char *only = find_argument("--only", argc, argv);
     BENCHMARK_CONFIG_TARGET_SECONDS = find_float_argument("--target_seconds", 0.5, 0, 10000, argc, argv);
-
+    BENCHMARK_CONFIG_TRIALS = (size_t)find_int64_argument("--trials", 1, 1, 1000, argc, argv);
+    BenchmarkOutputFormat format = find_enum_argument("--format", "text", format_name_to_enum_map, argc, argv);
+    const char *baseline_path = find_argument("--baseline", argc, argv);
+    double regression_threshold = find_float_argument("--regression_threshold", 0.1, 0, 1000, argc, argv);
+    auto out_stream = find_output_stream_argument("--out", true, argc, argv);
+    std::ostream &out = out_stream.stream();
+    std::map<std::string, double> baseline;
+    if (baseline_path != nullptr) {
+        baseline = read_baseline(baseline_path);
+    }
     std::vector<RegisteredBenchmark> chosen_benchmarks;
     if (only == nullptr) {
         chosen_benchmarks = all_registered_benchmarks;
@@ -141,44 +385,35 @@ int main(int argc, const char **argv) {
         }
     }
 
+    std::vector<NamedBenchmarkResult> results;
     for (auto &benchmark : chosen_benchmarks) {
         running_benchmark = &benchmark;
         benchmark.func();
-        for (const auto &result : benchmark.results) {
-            double actual_seconds_per_rep = result.total_seconds / result.total_reps;
-            if (result.goal_seconds != -1) {
-                int deviation = (int)round((log(result.goal_seconds) - log(actual_seconds_per_rep)) / (log(10) / 10.0));
-                std::cout << "[";
-                for (int k = -20; k <= 20; k++) {
-                    if ((k < deviation && k < 0) || (k > deviation && k > 0)) {
-                        std::cout << '.';
-                    } else if (k == deviation) {
-                        std::cout << '*';
-                    } else if (k == 0) {
-                        std::cout << '|';
-                    } else if (deviation < 0) {
-                        std::cout << '<';
-                    } else {
-                        std::cout << '>';
-                    }
-                }
-                std::cout << "] ";
-                std::cout << si2(actual_seconds_per_rep) << "s";
-                std::cout << " (vs " << si2(result.goal_seconds) << "s) ";
-            } else {
-                std::cout << si2(actual_seconds_per_rep) << "s ";
-            }
-            for (const auto &e : result.marginal_rates) {
-                const auto &multiplier = e.second;
-                const auto &unit = e.first;
-                std::cout << "(" << si2(result.total_reps / result.total_seconds * multiplier) << unit << "/s) ";
+        if (benchmark.results.empty()) {
+            std::cerr << "`benchmark_go` was not called from BENCH(" << benchmark.name << ")";
+            exit(EXIT_FAILURE);
+        }
+        for (size_t k = 0; k < benchmark.results.size(); k++) {
+            std::string name = benchmark.name;
+            if (k > 0) {
+                name += "#" + std::to_string(k);
             }
-            std::cout << benchmark.name << "\n";
-            if (benchmark.results.empty()) {
-                std::cerr << "`benchmark_go` was not called from BENCH(" << benchmark.name << ")";
-                exit(EXIT_FAILURE);
+            results.push_back({name, &benchmark.results[k]});
+            if (format == BENCHMARK_OUTPUT_TEXT) {
+                write_text_result(out, results.back());
+                out.flush();
             }
         }
     }
+
+    if (format == BENCHMARK_OUTPUT_JSON) {
+        write_json_results(out, results);
+    } else if (format == BENCHMARK_OUTPUT_CSV) {
+        write_csv_results(out, results);
+    }
+
+    if (baseline_path != nullptr && compare_to_baseline(results, baseline, regression_threshold)) {
+        return EXIT_FAILURE;
+    }
     return 0;
 }
@@ -16,21 +16,58 @@
 
 #ifndef STIM_BENCHMARK_UTIL_H
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <functional>
 #include <string>
 #include <vector>
 
 extern double BENCHMARK_CONFIG_TARGET_SECONDS;
+extern size_t BENCHMARK_CONFIG_TRIALS;
+
+/// Returns the median of the given values (or 0 if there are no values).
+inline double benchmark_median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    if (n & 1) {
+        return values[n >> 1];
+    }
+    return (values[(n >> 1) - 1] + values[n >> 1]) / 2;
+}
 
 struct BenchmarkResult {
     double total_seconds;
     size_t total_reps;
     std::vector<std::pair<std::string, double>> marginal_rates;
     double goal_seconds;
+    /// The average time taken by one repetition of the benchmark body, for each independently timed trial.
+    std::vector<double> trial_seconds_per_rep;
 
     BenchmarkResult(double total_seconds, size_t total_reps)
-        : total_seconds(total_seconds), total_reps(total_reps), marginal_rates(), goal_seconds(-1) {
+        : total_seconds(total_seconds),
+          total_reps(total_reps),
+          marginal_rates(),
+          goal_seconds(-1),
+          trial_seconds_per_rep() {
+    }
+
+    /// The median, over trials, of the time taken by one repetition.
+    double median_seconds_per_rep() const {
+        return benchmark_median(trial_seconds_per_rep);
+    }
+
+    /// The median absolute deviation, over trials, of the time taken by one repetition.
+    double mad_seconds_per_rep() const {
+        double median = median_seconds_per_rep();
+        std::vector<double> deviations;
+        for (double e : trial_seconds_per_rep) {
+            deviations.push_back(std::abs(e - median));
+        }
+        return benchmark_median(deviations);
     }
 
     BenchmarkResult &show_rate(const std::string &new_unit_name, double new_multiplier) {
@@ -74,7 +111,7 @@ extern std::vector<RegisteredBenchmark> all_registered_benchmarks;
 
 // HACK: Templating the body function type makes inlining significantly more likely.
 template <typename FUNC>
-BenchmarkResult &benchmark_go(FUNC body) {
+BenchmarkResult benchmark_trial(FUNC &body) {
     size_t total_reps = 0;
     double total_seconds = 0.0;
     double target_wait_time_seconds = BENCHMARK_CONFIG_TARGET_SECONDS;
@@ -104,7 +141,20 @@ BenchmarkResult &benchmark_go(FUNC body) {
         total_seconds += (double)micros / 1000.0 / 1000.0;
     }
 
-    running_benchmark->results.push_back({total_seconds, total_reps});
+    return {total_seconds, total_reps};
+}
+
+template <typename FUNC>
+BenchmarkResult &benchmark_go(FUNC body) {
+    BenchmarkResult result{0, 0};
+    for (size_t trial = 0; trial < BENCHMARK_CONFIG_TRIALS; trial++) {
+        BenchmarkResult t = benchmark_trial(body);
+        result.total_seconds += t.total_seconds;
+        result.total_reps += t.total_reps;
+        result.trial_seconds_per_rep.push_back(t.total_seconds / t.total_reps);
+    }
+
+    running_benchmark->results.push_back(result);
     return running_benchmark->results.back();
 }
 
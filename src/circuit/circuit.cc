@@ -984,6 +984,28 @@ void Circuit::append_repeat_block(uint64_t repeat_count, Circuit &&body) {
     operations.push_back({&GATE_DATA.at("REPEAT"), {{}, targets}});
 }
 
+void Circuit::set_noise_args(size_t operation_index, ConstPointerRange<double> args) {
+    if (operation_index >= operations.size()) {
+        throw std::invalid_argument(
+            "Operation index " + std::to_string(operation_index) + " is out of range for a circuit with " +
+            std::to_string(operations.size()) + " operations.");
+    }
+    auto &op = operations[operation_index];
+    if (!(op.gate->flags & (GATE_IS_NOISE | GATE_PRODUCES_NOISY_RESULTS))) {
+        throw std::invalid_argument(
+            "Operation " + std::to_string(operation_index) + " is a " + std::string(op.gate->name) +
+            " operation, which doesn't take noise arguments.");
+    }
+    if (args.size() != op.target_data.args.size()) {
+        throw std::invalid_argument(
+            "Operation " + std::to_string(operation_index) + " has " + std::to_string(op.target_data.args.size()) +
+            " arguments, but was given " + std::to_string(args.size()) + " arguments (" + comma_sep(args).str() +
+            ").");
+    }
+    validate_gate(*op.gate, op.target_data.targets, args);
+    std::copy(args.begin(), args.end(), op.target_data.args.begin());
+}
+
 void Circuit::append_repeat_block(uint64_t repeat_count, const Circuit &body) {
     if (repeat_count == 0) {
         throw std::invalid_argument("Can't repeat 0 times.");
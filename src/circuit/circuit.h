@@ -195,6 +195,16 @@ struct Circuit {
     /// Safely moves a repeat block to the end of the circuit.
     void append_repeat_block(uint64_t repeat_count, Circuit &&body);
 
+    /// Overwrites the probabilities of a top-level noisy operation, without changing the structure of the circuit.
+    ///
+    /// Only arguments that are ignored by the noiseless version of the circuit can be overwritten (the probabilities
+    /// of noise channels and the result flip probabilities of measurements). Anything derived from the noiseless
+    /// circuit, such as a reference sample, stays valid.
+    ///
+    /// Throws:
+    ///     std::invalid_argument: The operation isn't noisy, the number of arguments changed, or they're invalid.
+    void set_noise_args(size_t operation_index, ConstPointerRange<double> args);
+
     /// Resets the circuit back to an empty circuit.
     void clear();
 
@@ -28,6 +28,125 @@
 
 using namespace stim_internal;
 
+static_assert(sizeof(GateTarget) == sizeof(uint32_t), "GateTarget must be a plain uint32_t for numpy interop.");
+
+/// Converts the `arg` argument of `stim.Circuit.append_operation` into the gate's parens arguments.
+static std::vector<double> obj_to_gate_args(const pybind11::object &arg) {
+    if (pybind11::isinstance<pybind11::array>(arg)) {
+        using double_array = pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast>;
+        auto args = pybind11::cast<double_array>(arg);
+        if (args.ndim() != 1) {
+            throw std::invalid_argument("A numpy array of gate args must be one dimensional.");
+        }
+        return {args.data(), args.data() + args.size()};
+    }
+    try {
+        return {pybind11::cast<double>(arg)};
+    } catch (const pybind11::cast_error &ex) {
+    }
+    try {
+        return pybind11::cast<std::vector<double>>(arg);
+    } catch (const pybind11::cast_error &ex) {
+    }
+    throw std::invalid_argument("Arg must be a double or sequence of doubles.");
+}
+
+/// Converts the `targets` argument of `stim.Circuit.append_operation`, when it isn't a numpy array, into a list.
+///
+/// Sequences are converted the same way as a `std::vector<pybind11::object>` argument (which excludes str and bytes).
+/// Other iterables, such as generators, are consumed into a tuple first.
+static std::vector<pybind11::object> obj_to_target_objects(const pybind11::object &targets) {
+    bool is_text = pybind11::isinstance<pybind11::str>(targets) || pybind11::isinstance<pybind11::bytes>(targets);
+    if (!is_text && !pybind11::isinstance<pybind11::sequence>(targets) &&
+        pybind11::isinstance<pybind11::iterable>(targets)) {
+        return pybind11::cast<std::vector<pybind11::object>>(pybind11::tuple(targets));
+    }
+    try {
+        return pybind11::cast<std::vector<pybind11::object>>(targets);
+    } catch (const pybind11::cast_error &ex) {
+    }
+    throw pybind11::type_error("Targets must be a sequence of gate targets or a numpy array with dtype uint32.");
+}
+
+/// Appends an operation whose targets come from a numpy uint32 array, copying the array's data in one block.
+static void append_numpy_operation(
+    Circuit &self, const std::string &gate_name, const pybind11::object &targets, const pybind11::object &arg) {
+    const auto &gate = GATE_DATA.at(gate_name);
+    auto raw_targets = pybind11::cast<pybind11::array_t<uint32_t, pybind11::array::c_style>>(targets);
+    if (raw_targets.ndim() != 1) {
+        throw std::invalid_argument("A numpy array of targets must be one dimensional.");
+    }
+    const auto *begin = reinterpret_cast<const GateTarget *>(raw_targets.data());
+    self.append_operation(gate, {begin, begin + raw_targets.size()}, obj_to_gate_args(arg));
+}
+
+/// Packs a circuit's operations into flat arrays, for `stim.Circuit.to_numpy_arrays`.
+struct CircuitArraysBuilder {
+    std::vector<std::string> names;
+    std::vector<uint8_t> codes;
+    std::vector<uint64_t> target_offsets{0};
+    std::vector<uint32_t> targets;
+    std::vector<uint64_t> arg_offsets{0};
+    std::vector<double> args;
+    uint8_t code_of_gate_id[256];
+
+    CircuitArraysBuilder() {
+        std::fill(std::begin(code_of_gate_id), std::end(code_of_gate_id), UINT8_MAX);
+    }
+
+    void add_operation(const Gate &gate, ConstPointerRange<GateTarget> op_targets, ConstPointerRange<double> op_args) {
+        if (code_of_gate_id[gate.id] == UINT8_MAX) {
+            code_of_gate_id[gate.id] = (uint8_t)names.size();
+            names.push_back(gate.name);
+        }
+        codes.push_back(code_of_gate_id[gate.id]);
+        for (auto t : op_targets) {
+            targets.push_back(t.data);
+        }
+        target_offsets.push_back(targets.size());
+        args.insert(args.end(), op_args.begin(), op_args.end());
+        arg_offsets.push_back(args.size());
+    }
+
+    void add_circuit(const Circuit &circuit, bool flatten_loops) {
+        for (const auto &op : circuit.operations) {
+            if (op.gate->id != gate_name_to_id("REPEAT")) {
+                add_operation(*op.gate, op.target_data.targets, op.target_data.args);
+                continue;
+            }
+
+            const Circuit &body = op_data_block_body(circuit, op.target_data);
+            uint64_t repetitions = op_data_rep_count(op.target_data);
+            if (flatten_loops) {
+                for (uint64_t k = 0; k < repetitions; k++) {
+                    add_circuit(body, true);
+                }
+            } else {
+                // The body follows the REPEAT entry, whose last target records how many entries the body used.
+                GateTarget header[3]{
+                    GateTarget{(uint32_t)(repetitions & 0xFFFFFFFFULL)},
+                    GateTarget{(uint32_t)(repetitions >> 32)},
+                    GateTarget{0}};
+                add_operation(*op.gate, {&header[0], &header[3]}, {});
+                size_t header_index = codes.size() - 1;
+                add_circuit(body, false);
+                targets[target_offsets[header_index + 1] - 1] = (uint32_t)(codes.size() - header_index - 1);
+            }
+        }
+    }
+
+    pybind11::dict to_dict() const {
+        pybind11::dict result;
+        result["instruction_names"] = names;
+        result["instruction_codes"] = vec_to_numpy(codes);
+        result["target_offsets"] = vec_to_numpy(target_offsets);
+        result["targets"] = vec_to_numpy(targets);
+        result["arg_offsets"] = vec_to_numpy(arg_offsets);
+        result["args"] = vec_to_numpy(args);
+        return result;
+    }
+};
+
 std::string circuit_repr(const Circuit &self) {
     if (self.operations.empty()) {
         return "stim.Circuit()";
@@ -336,6 +455,76 @@ void pybind_circuit(pybind11::module &m) {
         )DOC")
             .data());
 
+    c.def(
+        "to_numpy_arrays",
+        [](const Circuit &self, bool flatten_loops) {
+            CircuitArraysBuilder builder;
+            builder.add_circuit(self, flatten_loops);
+            return builder.to_dict();
+        },
+        pybind11::kw_only(),
+        pybind11::arg("flatten_loops") = false,
+        clean_doc_string(u8R"DOC(
+            Exports the circuit's instructions as flat numpy arrays, in one call.
+
+            Avoids creating python objects for each instruction and target, which makes it much faster than
+            iterating over the circuit (or over `flattened_operations()`) when the circuit is large. The layout
+            resembles a compressed sparse row matrix: the targets of instruction k are
+            `targets[target_offsets[k]:target_offsets[k + 1]]` and its parens arguments are
+            `args[arg_offsets[k]:arg_offsets[k + 1]]`.
+
+            Args:
+                flatten_loops: Defaults to False. When True, the instructions in REPEAT blocks are repeated in the
+                    output instead of being nested inside REPEAT entries.
+
+            Returns:
+                A dictionary with the following entries:
+                    "instruction_names": A List[str] of gate names (e.g. "H" or "CX"), indexed by instruction code.
+                    "instruction_codes": A `numpy.ndarray[uint8]` with the code of each instruction.
+                    "target_offsets": A `numpy.ndarray[uint64]` with one more entry than there are instructions.
+                    "targets": A `numpy.ndarray[uint32]` of encoded gate targets, in the same encoding used by
+                        `stim.target_inv`, `stim.target_rec`, `stim.target_x`, etc. This array can be passed back
+                        into `stim.Circuit.append_operation`.
+                    "arg_offsets": A `numpy.ndarray[uint64]` with one more entry than there are instructions.
+                    "args": A `numpy.ndarray[float64]` of the instructions' parens arguments.
+
+                When loops aren't flattened, a REPEAT block becomes a "REPEAT" entry followed by the entries of its
+                body. The REPEAT entry has three targets: the low 32 bits of the repetition count, the high 32 bits
+                of the repetition count, and the number of entries that make up the body (including the entries of
+                any nested blocks).
+
+            Examples:
+                >>> import stim
+                >>> arrays = stim.Circuit('''
+                ...    H 0 1
+                ...    X_ERROR(0.125) 1
+                ...    M 0 1
+                ... ''').to_numpy_arrays()
+                >>> arrays["instruction_names"]
+                ['H', 'X_ERROR', 'M']
+                >>> arrays["instruction_codes"]
+                array([0, 1, 2], dtype=uint8)
+                >>> arrays["target_offsets"]
+                array([0, 2, 3, 5], dtype=uint64)
+                >>> arrays["targets"]
+                array([0, 1, 1, 0, 1], dtype=uint32)
+                >>> arrays["arg_offsets"]
+                array([0, 0, 1, 1], dtype=uint64)
+                >>> arrays["args"]
+                array([0.125])
+
+                >>> loop = stim.Circuit('''
+                ...    REPEAT 2 {
+                ...        H 6
+                ...    }
+                ... ''')
+                >>> loop.to_numpy_arrays()["targets"]
+                array([2, 0, 1, 6], dtype=uint32)
+                >>> loop.to_numpy_arrays(flatten_loops=True)["targets"]
+                array([6, 6], dtype=uint32)
+        )DOC")
+            .data());
+
     c.def(pybind11::self == pybind11::self, "Determines if two circuits have identical contents.");
     c.def(pybind11::self != pybind11::self, "Determines if two circuits have non-identical contents.");
 
@@ -448,7 +637,7 @@ void pybind_circuit(pybind11::module &m) {
         "append_operation",
         [](Circuit &self,
            const pybind11::object &obj,
-           const std::vector<pybind11::object> &targets,
+           const pybind11::object &targets,
            pybind11::object arg) {
             if (pybind11::isinstance<pybind11::str>(obj)) {
                 const std::string &gate_name = pybind11::cast<std::string>(obj);
@@ -459,25 +648,17 @@ void pybind_circuit(pybind11::module &m) {
                         arg = pybind11::make_tuple();
                     }
                 }
-                std::vector<uint32_t> raw_targets;
-                for (const auto &t : targets) {
-                    raw_targets.push_back(obj_to_gate_target(t).data);
-                }
-                try {
-                    auto d = pybind11::cast<double>(arg);
-                    self.append_op(gate_name, raw_targets, d);
+                if (pybind11::isinstance<pybind11::array_t<uint32_t>>(targets)) {
+                    append_numpy_operation(self, gate_name, targets, arg);
                     return;
-                } catch (const pybind11::cast_error &ex) {
                 }
-                try {
-                    auto args = pybind11::cast<std::vector<double>>(arg);
-                    self.append_op(gate_name, raw_targets, args);
-                    return;
-                } catch (const pybind11::cast_error &ex) {
+                std::vector<uint32_t> raw_targets;
+                for (const auto &t : obj_to_target_objects(targets)) {
+                    raw_targets.push_back(obj_to_gate_target(t).data);
                 }
-                throw std::invalid_argument("Arg must be a double or sequence of doubles.");
+                self.append_op(gate_name, raw_targets, obj_to_gate_args(arg));
             } else if (pybind11::isinstance<CircuitInstruction>(obj)) {
-                if (!targets.empty() || !arg.is_none()) {
+                if (!obj_to_target_objects(targets).empty() || !arg.is_none()) {
                     throw std::invalid_argument(
                         "Can't specify `targets` or `arg` when appending a stim.CircuitInstruction.");
                 }
@@ -485,7 +666,7 @@ void pybind_circuit(pybind11::module &m) {
                 const CircuitInstruction &instruction = pybind11::cast<CircuitInstruction>(obj);
                 self.append_op(instruction.gate.name, instruction.raw_targets(), instruction.gate_args);
             } else if (pybind11::isinstance<CircuitRepeatBlock>(obj)) {
-                if (!targets.empty() || !arg.is_none()) {
+                if (!obj_to_target_objects(targets).empty() || !arg.is_none()) {
                     throw std::invalid_argument(
                         "Can't specify `targets` or `arg` when appending a stim.CircuitRepeatBlock.");
                 }
@@ -522,6 +703,14 @@ void pybind_circuit(pybind11::module &m) {
                 X_ERROR(0.125) 0
                 E(0.25) X0 Y2
 
+                >>> import numpy as np
+                >>> c = stim.Circuit()
+                >>> c.append_operation("CNOT", np.array([0, 1, 2, 3], dtype=np.uint32))
+                >>> c.append_operation("DEPOLARIZE1", np.arange(4, dtype=np.uint32), np.array([0.25]))
+                >>> print(c)
+                CX 0 1 2 3
+                DEPOLARIZE1(0.25) 0 1 2 3
+
             Args:
                 name: The name of the operation's gate (e.g. "H" or "M" or "CNOT").
 
@@ -531,6 +720,12 @@ void pybind_circuit(pybind11::module &m) {
 
                     (The argument name `name` is no longer quite right, but being kept for backwards compatibility.)
                 targets: The gate targets. Gates implicitly broadcast over their targets.
+
+                    This argument can also be a 1d numpy array with dtype `numpy.uint32`, containing encoded targets
+                    (e.g. `stim.target_inv(1)` or `stim.target_rec(-1)`) or plain qubit indices. The array's data is
+                    copied directly into the circuit, without converting each target individually, which is much
+                    faster when appending millions of targets. When targets are given this way, `arg` can also be a
+                    numpy array of floats.
                 arg: A double or list of doubles parameterizing the gate. Different gates take different arguments. For
                     example, X_ERROR takes a probability, OBSERVABLE_INCLUDE takes an observable index, and PAULI_CHANNEL_1
                     takes three disjoint probabilities. For backwards compatibility reasons, defaults to (0,) for gates
@@ -979,3 +979,41 @@ TEST(circuit, append_repeat_block) {
     ASSERT_THROW({ c.append_repeat_block(0, a); }, std::invalid_argument);
     ASSERT_THROW({ c.append_repeat_block(0, std::move(a)); }, std::invalid_argument);
 }
+
+TEST(circuit, set_noise_args) {
+    Circuit c(R"CIRCUIT(
+        H 0
+        X_ERROR(0.125) 0 1
+        M(0.25) 0
+        PAULI_CHANNEL_1(0.125, 0.25, 0.125) 1
+        REPEAT 2 {
+            X_ERROR(0.125) 0
+        }
+    )CIRCUIT");
+    std::vector<double> a{0.5};
+    std::vector<double> b{0.25, 0.25, 0.5};
+    c.set_noise_args(1, a);
+    c.set_noise_args(2, a);
+    c.set_noise_args(3, b);
+    ASSERT_EQ(c, Circuit(R"CIRCUIT(
+        H 0
+        X_ERROR(0.5) 0 1
+        M(0.5) 0
+        PAULI_CHANNEL_1(0.25, 0.25, 0.5) 1
+        REPEAT 2 {
+            X_ERROR(0.125) 0
+        }
+    )CIRCUIT"));
+
+    std::vector<double> too_large{1.5};
+    std::vector<double> too_many{0.25, 0.25};
+    std::vector<double> sum_too_large{0.5, 0.5, 0.5};
+    ASSERT_THROW({ c.set_noise_args(0, a); }, std::invalid_argument);
+    ASSERT_THROW({ c.set_noise_args(4, a); }, std::invalid_argument);
+    ASSERT_THROW({ c.set_noise_args(5, a); }, std::invalid_argument);
+    ASSERT_THROW({ c.set_noise_args(1, too_large); }, std::invalid_argument);
+    ASSERT_THROW({ c.set_noise_args(1, too_many); }, std::invalid_argument);
+    ASSERT_THROW({ c.set_noise_args(3, sum_too_large); }, std::invalid_argument);
+    ASSERT_EQ(c.operations[1].target_data.args[0], 0.5);
+    ASSERT_EQ(c.operations[3].target_data.args[2], 0.5);
+}
@@ -514,3 +514,95 @@ def test_append_instructions_and_blocks():
 
     with pytest.raises(ValueError, match="repeat 0"):
         c.append_operation(stim.CircuitRepeatBlock(0, stim.Circuit("H 1")))
+
+
+def test_append_operation_generator_targets():
+    c = stim.Circuit()
+    c.append_operation("H", (q for q in range(3)))
+    c.append_operation("CX", (t for t in [0, 1, 2, 3]))
+    c.append_operation("X_ERROR", iter([4, 5]), 0.125)
+    c.append_operation(stim.Circuit("Y 6")[0], (t for t in []))
+    assert c == stim.Circuit("""
+        H 0 1 2
+        CX 0 1 2 3
+        X_ERROR(0.125) 4 5
+        Y 6
+    """)
+
+    with pytest.raises(ValueError, match="targets"):
+        c.append_operation(stim.Circuit("H 1")[0], (t for t in [2]))
+    with pytest.raises(TypeError):
+        c.append_operation("H", "01")
+
+
+def test_append_operation_numpy_targets():
+    c = stim.Circuit()
+    c.append_operation("CNOT", np.array([0, 1, 2, 3], dtype=np.uint32))
+    c.append_operation("M", np.array([0, stim.target_inv(1)], dtype=np.uint32))
+    c.append_operation("CX", np.array([stim.target_rec(-1), 5], dtype=np.uint32))
+    c.append_operation("X_ERROR", np.arange(3, dtype=np.uint32), 0.125)
+    c.append_operation("PAULI_CHANNEL_1", np.array([4], dtype=np.uint32), np.array([0.1, 0.2, 0.3]))
+    c.append_operation("E", np.array([stim.target_x(0), stim.target_y(2)], dtype=np.uint32), [0.25])
+    assert c == stim.Circuit("""
+        CX 0 1 2 3
+        M 0 !1
+        CX rec[-1] 5
+        X_ERROR(0.125) 0 1 2
+        PAULI_CHANNEL_1(0.1, 0.2, 0.3) 4
+        E(0.25) X0 Y2
+    """)
+
+    c = stim.Circuit()
+    c.append_operation("H", np.arange(100000, dtype=np.uint32)[::2])
+    assert c == stim.Circuit("H " + " ".join(str(k) for k in range(0, 100000, 2)))
+
+    with pytest.raises(ValueError, match="one dimensional"):
+        c.append_operation("H", np.zeros(shape=(2, 2), dtype=np.uint32))
+    with pytest.raises(ValueError, match="even number"):
+        c.append_operation("CNOT", np.array([0, 1, 2], dtype=np.uint32))
+    with pytest.raises(ValueError):
+        c.append_operation("X_ERROR", np.array([0], dtype=np.uint32), np.array([0.1, 0.2]))
+
+
+def test_to_numpy_arrays():
+    circuit = stim.Circuit("""
+        H 0 1
+        REPEAT 2 {
+            CNOT 0 1
+            REPEAT 3 {
+                X_ERROR(0.25) 1
+            }
+        }
+        M 0 !1
+        DETECTOR(1, 2) rec[-1]
+    """)
+    arrays = circuit.to_numpy_arrays()
+    names = arrays["instruction_names"]
+    assert [names[k] for k in arrays["instruction_codes"]] == [
+        'H', 'REPEAT', 'CX', 'REPEAT', 'X_ERROR', 'M', 'DETECTOR',
+    ]
+    np.testing.assert_array_equal(arrays["target_offsets"], [0, 2, 5, 7, 10, 11, 13, 14])
+    np.testing.assert_array_equal(
+        arrays["targets"],
+        np.array([0, 1, 2, 0, 3, 0, 1, 3, 0, 1, 1, 0, stim.target_inv(1), stim.target_rec(-1)], dtype=np.uint32))
+    np.testing.assert_array_equal(arrays["arg_offsets"], [0, 0, 0, 0, 0, 1, 1, 3])
+    np.testing.assert_array_equal(arrays["args"], [0.25, 1, 2])
+
+    arrays = circuit.to_numpy_arrays(flatten_loops=True)
+    names = arrays["instruction_names"]
+    ops = circuit.flattened_operations()
+    assert [names[k] for k in arrays["instruction_codes"]] == [name for name, _, _ in ops]
+    rebuilt = stim.Circuit()
+    for k in range(len(arrays["instruction_codes"])):
+        t = arrays["targets"][arrays["target_offsets"][k]:arrays["target_offsets"][k + 1]]
+        a = arrays["args"][arrays["arg_offsets"][k]:arrays["arg_offsets"][k + 1]]
+        rebuilt.append_operation(names[arrays["instruction_codes"][k]], t, a)
+    assert rebuilt == stim.Circuit("""
+        H 0 1
+        CX 0 1
+        X_ERROR(0.25) 1 1 1
+        CX 0 1
+        X_ERROR(0.25) 1 1 1
+        M 0 !1
+        DETECTOR(1, 2) rec[-1]
+    """)
@@ -30,12 +30,14 @@
 #include <vector>
 
 #include "../simd/fixed_cap_vector.h"
+#include "../simd/pointer_range.h"
 
 namespace stim_internal {
 
 struct TableauSimulator;
 struct FrameSimulator;
 struct OperationData;
+struct GateTarget;
 struct Tableau;
 struct Operation;
 struct ErrorAnalyzer;
@@ -285,6 +287,16 @@ void decompose_mpp_operation(
         const OperationData &h_xz, const OperationData &h_yz, const OperationData &cnot, const OperationData &meas)>
         &callback);
 
+/// Calls the callback with the targets of each Pauli product in an MPP operation, with the combiners removed.
+///
+/// Used by simulators with native Pauli product measurement kernels, which measure the products one by one instead
+/// of decomposing them into layers of basis changes, CNOTs, and single qubit measurements.
+///
+/// Throws:
+///     std::invalid_argument: A Pauli product specified the same qubit twice.
+void for_each_mpp_product(
+    const OperationData &target_data, const std::function<void(ConstPointerRange<GateTarget> product)> &callback);
+
 }  // namespace stim_internal
 
 #endif
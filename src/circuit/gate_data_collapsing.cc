@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "../simulators/error_analyzer.h"
 #include "../simulators/frame_simulator.h"
 #include "../simulators/tableau_simulator.h"
@@ -324,3 +326,33 @@ void stim_internal::decompose_mpp_operation(
     // Flush remaining groups.
     callback(op_dat(h_xz, {}), op_dat(h_yz, {}), op_dat(cnot, {}), op_dat(meas, target_data.args));
 }
+
+void stim_internal::for_each_mpp_product(
+    const OperationData &target_data, const std::function<void(ConstPointerRange<GateTarget> product)> &callback) {
+    std::vector<GateTarget> product;
+    std::vector<uint32_t> sorted_qubits;
+    size_t start = 0;
+    while (start < target_data.targets.size()) {
+        size_t end = start + 1;
+        while (end < target_data.targets.size() && target_data.targets[end].is_combiner()) {
+            end += 2;
+        }
+
+        product.clear();
+        sorted_qubits.clear();
+        for (size_t i = start; i < end; i += 2) {
+            product.push_back(target_data.targets[i]);
+            sorted_qubits.push_back(target_data.targets[i].qubit_value());
+        }
+        std::sort(sorted_qubits.begin(), sorted_qubits.end());
+        if (std::adjacent_find(sorted_qubits.begin(), sorted_qubits.end()) != sorted_qubits.end()) {
+            throw std::invalid_argument(
+                "A pauli product specified the same qubit twice.\n"
+                "The operation: MPP" +
+                target_data.str());
+        }
+        callback(product);
+
+        start = end;
+    }
+}
@@ -18,6 +18,7 @@
 
 #include <cmath>
 #include <iomanip>
+#include <limits>
 
 #include "../simulators/error_analyzer.h"
 #include "../str_util.h"
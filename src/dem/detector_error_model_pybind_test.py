@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy as np
 import stim
 
 
@@ -97,3 +98,44 @@ def test_repr():
     assert eval(repr(v), {"stim": stim}) == v
     v = stim.DetectorErrorModel("error(0.125) D0 D1")
     assert eval(repr(v), {"stim": stim}) == v
+
+
+def test_to_numpy_arrays():
+    model = stim.DetectorErrorModel("""
+        error(0.125) D0 L1
+        error(0.25) D0 ^ D1
+        repeat 2 {
+            repeat 3 {
+                error(0.5) D2
+            }
+            detector(1, 2) D0
+            shift_detectors(0, 5) 2
+        }
+        logical_observable L3
+    """)
+    arrays = model.to_numpy_arrays()
+    assert arrays["instruction_names"] == ['error', 'shift_detectors', 'detector', 'logical_observable', 'repeat']
+    np.testing.assert_array_equal(arrays["instruction_codes"], [0, 0, 4, 4, 0, 2, 1, 3])
+    np.testing.assert_array_equal(arrays["target_offsets"], [0, 2, 5, 7, 9, 10, 11, 12, 13])
+    np.testing.assert_array_equal(
+        arrays["targets"],
+        np.array([0, 2**63 + 1, 0, 2**64 - 1, 1, 2, 4, 3, 1, 2, 0, 2, 2**63 + 3], dtype=np.uint64))
+    np.testing.assert_array_equal(arrays["arg_offsets"], [0, 1, 2, 2, 2, 3, 5, 7, 7])
+    np.testing.assert_array_equal(arrays["args"], [0.125, 0.25, 0.5, 1, 2, 0, 5])
+
+    arrays = model.to_numpy_arrays(flatten_loops=True)
+    names = arrays["instruction_names"]
+    assert [names[k] for k in arrays["instruction_codes"]] == [
+        'error', 'error', 'error', 'error', 'error', 'detector', 'error', 'error', 'error', 'detector',
+        'logical_observable',
+    ]
+    np.testing.assert_array_equal(
+        arrays["targets"],
+        np.array([0, 2**63 + 1, 0, 2**64 - 1, 1, 2, 2, 2, 0, 4, 4, 4, 2, 2**63 + 3], dtype=np.uint64))
+    np.testing.assert_array_equal(arrays["args"], [0.125, 0.25, 0.5, 0.5, 0.5, 1, 2, 0.5, 0.5, 0.5, 1, 7])
+    assert arrays["target_offsets"][-1] == len(arrays["targets"])
+    assert arrays["arg_offsets"][-1] == len(arrays["args"])
+
+    empty = stim.DetectorErrorModel().to_numpy_arrays()
+    assert len(empty["instruction_codes"]) == 0
+    np.testing.assert_array_equal(empty["target_offsets"], [0])
@@ -1,5 +1,7 @@
 #include "circuit_gen_main.h"
 
+#include <cstring>
+
 #include "../arg_parse.h"
 #include "circuit_gen_params.h"
 #include "gen_color_code.h"
@@ -12,7 +14,7 @@ std::map<std::string, GeneratedCircuit (*)(const CircuitGenParameters &)> code_n
     {"color_code", &generate_color_code_circuit},
     {"repetition_code", &generate_rep_code_circuit},
     {"surface_code", &generate_surface_code_circuit}};
-std::vector<const char *> known_commands{
+static std::vector<const char *> known_commands{
     "--after_clifford_depolarization",
     "--after_reset_flip_probability",
     "--task",
@@ -25,9 +27,11 @@ std::vector<const char *> known_commands{
     "--rounds",
 };
 
-int stim_internal::main_generate_circuit(int argc, const char **argv) {
-    check_for_unknown_arguments(known_commands, "--gen", argc, argv);
-    auto func = find_enum_argument("--gen", nullptr, code_name_to_func_map, argc, argv);
+const std::vector<const char *> &stim_internal::circuit_gen_known_arguments() {
+    return known_commands;
+}
+
+static CircuitGenParameters circuit_gen_params_from_args(int argc, const char **argv) {
     CircuitGenParameters params(
         (uint64_t)find_int64_argument("--rounds", -1, 1, INT64_MAX, argc, argv),
         (uint32_t)find_int64_argument("--distance", -1, 2, 2047, argc, argv),
@@ -38,6 +42,104 @@ int stim_internal::main_generate_circuit(int argc, const char **argv) {
         find_float_argument("--before_measure_flip_probability", 0, 0, 1, argc, argv);
     params.after_reset_flip_probability = find_float_argument("--after_reset_flip_probability", 0, 0, 1, argc, argv);
     params.after_clifford_depolarization = find_float_argument("--after_clifford_depolarization", 0, 0, 1, argc, argv);
+    return params;
+}
+
+GeneratedCircuit stim_internal::generate_circuit_from_args(int argc, const char **argv) {
+    return generate_circuit_from_args(argc, argv, circuit_gen_params_from_args(argc, argv));
+}
+
+GeneratedCircuit stim_internal::generate_circuit_from_args(
+    int argc, const char **argv, const CircuitGenParameters &params) {
+    auto func = find_enum_argument("--gen", nullptr, code_name_to_func_map, argc, argv);
+    return func(params);
+}
+
+/// Splits a possibly comma separated argument into single valued arguments, so each can be parsed and validated by
+/// the usual argument parsing methods. Yields nothing if the argument isn't present.
+static std::vector<std::string> split_list_argument(const char *name, int argc, const char **argv) {
+    std::vector<std::string> result;
+    const char *text = find_argument(name, argc, argv);
+    if (text == nullptr) {
+        return result;
+    }
+    std::string prefix = std::string(name) + "=";
+    const char *start = text;
+    while (true) {
+        const char *end = strchr(start, ',');
+        if (end == nullptr) {
+            result.push_back(prefix + start);
+            break;
+        }
+        result.push_back(prefix + std::string(start, end));
+        start = end + 1;
+    }
+    return result;
+}
+
+static std::vector<double> find_float_list_argument(
+    const char *name, float default_value, float min_value, float max_value, int argc, const char **argv) {
+    auto pieces = split_list_argument(name, argc, argv);
+    if (pieces.empty()) {
+        return {find_float_argument(name, default_value, min_value, max_value, argc, argv)};
+    }
+    std::vector<double> result;
+    for (const auto &piece : pieces) {
+        const char *single_argv[]{argv[0], piece.data()};
+        result.push_back(find_float_argument(name, default_value, min_value, max_value, 2, single_argv));
+    }
+    return result;
+}
+
+static std::vector<int64_t> find_int64_list_argument(
+    const char *name, int64_t default_value, int64_t min_value, int64_t max_value, int argc, const char **argv) {
+    auto pieces = split_list_argument(name, argc, argv);
+    if (pieces.empty()) {
+        return {find_int64_argument(name, default_value, min_value, max_value, argc, argv)};
+    }
+    std::vector<int64_t> result;
+    for (const auto &piece : pieces) {
+        const char *single_argv[]{argv[0], piece.data()};
+        result.push_back(find_int64_argument(name, default_value, min_value, max_value, 2, single_argv));
+    }
+    return result;
+}
+
+std::vector<CircuitGenParameters> stim_internal::circuit_gen_sweep_from_args(int argc, const char **argv) {
+    auto distances = find_int64_list_argument("--distance", -1, 2, 2047, argc, argv);
+    auto rounds = find_int64_list_argument("--rounds", -1, 1, INT64_MAX, argc, argv);
+    const char *task = require_find_argument("--task", argc, argv);
+    auto after_clifford = find_float_list_argument("--after_clifford_depolarization", 0, 0, 1, argc, argv);
+    auto after_reset = find_float_list_argument("--after_reset_flip_probability", 0, 0, 1, argc, argv);
+    auto before_measure = find_float_list_argument("--before_measure_flip_probability", 0, 0, 1, argc, argv);
+    auto before_round = find_float_list_argument("--before_round_data_depolarization", 0, 0, 1, argc, argv);
+
+    std::vector<CircuitGenParameters> result;
+    for (auto d : distances) {
+        for (auto r : rounds) {
+            for (auto p1 : after_clifford) {
+                for (auto p2 : after_reset) {
+                    for (auto p3 : before_measure) {
+                        for (auto p4 : before_round) {
+                            CircuitGenParameters params((uint64_t)r, (uint32_t)d, task);
+                            params.after_clifford_depolarization = p1;
+                            params.after_reset_flip_probability = p2;
+                            params.before_measure_flip_probability = p3;
+                            params.before_round_data_depolarization = p4;
+                            result.push_back(params);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+int stim_internal::main_generate_circuit(int argc, const char **argv) {
+    check_for_unknown_arguments(known_commands, "--gen", argc, argv);
+    auto func = find_enum_argument("--gen", nullptr, code_name_to_func_map, argc, argv);
+    auto params = circuit_gen_params_from_args(argc, argv);
     auto out_stream = find_output_stream_argument("--out", true, argc, argv);
     std::ostream &out = out_stream.stream();
     out << "# Generated " << find_argument("--gen", argc, argv) << " circuit.\n";
@@ -6,9 +6,29 @@
 #include <stdint.h>
 
 #include "../circuit/circuit.h"
+#include "circuit_gen_params.h"
 
 namespace stim_internal {
 int main_generate_circuit(int argc, const char **argv);
+
+/// Generates the circuit described by the `--gen`, `--task`, `--distance`, `--rounds` and noise command line arguments.
+///
+/// Doesn't check for unknown arguments, so that the generated circuit can be handed to another mode (e.g. `--detect`)
+/// instead of being printed.
+GeneratedCircuit generate_circuit_from_args(int argc, const char **argv);
+
+/// Returns one set of parameters for each point in the sweep described by the command line arguments.
+///
+/// The `--distance`, `--rounds` and noise arguments may each be given a comma separated list of values (e.g.
+/// `--distance=3,5,7`). The result is the cartesian product of the given values, ordered with the rightmost argument
+/// in the usage documentation varying fastest. When no lists are given, the result has a single entry.
+std::vector<CircuitGenParameters> circuit_gen_sweep_from_args(int argc, const char **argv);
+
+/// Generates the circuit for the `--gen` code family, using the given parameters instead of the parameter arguments.
+GeneratedCircuit generate_circuit_from_args(int argc, const char **argv, const CircuitGenParameters &params);
+
+/// The command line arguments used by circuit generation mode.
+const std::vector<const char *> &circuit_gen_known_arguments();
 }
 
 #endif
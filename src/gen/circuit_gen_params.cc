@@ -1,5 +1,7 @@
 #include "circuit_gen_params.h"
 
+#include <sstream>
+
 #include "../arg_parse.h"
 
 using namespace stim_internal;
@@ -33,6 +35,18 @@ CircuitGenParameters::CircuitGenParameters(uint64_t rounds, uint32_t distance, s
     : rounds(rounds), distance(distance), task(task) {
 }
 
+std::string CircuitGenParameters::str() const {
+    std::stringstream ss;
+    ss << "task=" << task;
+    ss << " distance=" << distance;
+    ss << " rounds=" << rounds;
+    ss << " after_clifford_depolarization=" << after_clifford_depolarization;
+    ss << " after_reset_flip_probability=" << after_reset_flip_probability;
+    ss << " before_measure_flip_probability=" << before_measure_flip_probability;
+    ss << " before_round_data_depolarization=" << before_round_data_depolarization;
+    return ss.str();
+}
+
 void CircuitGenParameters::append_begin_round_tick(Circuit &circuit, const std::vector<uint32_t> &data_qubits) const {
     circuit.append_op("TICK", {});
     if (before_round_data_depolarization > 0) {
@@ -18,6 +18,8 @@ struct CircuitGenParameters {
     double after_reset_flip_probability = 0;
 
     void validate_params() const;
+    /// Describes the parameters as space separated `key=value` pairs.
+    std::string str() const;
 
     CircuitGenParameters(uint64_t rounds, uint32_t distance, std::string task);
     void append_begin_round_tick(Circuit &circuit, const std::vector<uint32_t> &data_qubits) const;
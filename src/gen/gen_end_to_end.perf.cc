@@ -0,0 +1,217 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// End to end benchmarks using the circuits produced by `stim --gen`, at sizes similar to what's used in practice.
+
+#include <iostream>
+#include <sstream>
+
+#include "../benchmark_util.h"
+#include "../simulators/detection_simulator.h"
+#include "../simulators/error_analyzer.h"
+#include "../simulators/frame_simulator.h"
+#include "../simulators/tableau_simulator.h"
+#include "gen_color_code.h"
+#include "gen_rep_code.h"
+#include "gen_surface_code.h"
+
+using namespace stim_internal;
+
+static Circuit gen_circuit(const std::string &task, uint32_t distance, uint64_t rounds) {
+    CircuitGenParameters params(rounds, distance, task);
+    params.after_clifford_depolarization = 0.001;
+    params.after_reset_flip_probability = 0.001;
+    params.before_measure_flip_probability = 0.001;
+    params.before_round_data_depolarization = 0.001;
+    if (task == "memory") {
+        return generate_rep_code_circuit(params).circuit;
+    }
+    if (task == "memory_xyz") {
+        return generate_color_code_circuit(params).circuit;
+    }
+    return generate_surface_code_circuit(params).circuit;
+}
+
+static std::string flattened_text(const Circuit &circuit) {
+    std::stringstream ss;
+    circuit.for_each_operation([&](const Operation &op) {
+        ss << op << "\n";
+    });
+    return ss.str();
+}
+
+static BenchmarkResult &bench_detect(const Circuit &circuit, size_t num_shots) {
+    FILE *out = tmpfile();
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    auto &result = benchmark_go([&]() {
+        rewind(out);
+        detector_samples_out(circuit, num_shots, false, true, out, SAMPLE_FORMAT_B8, rng);
+    });
+    fclose(out);
+    return result.show_rate("Dets", (double)circuit.count_detectors() * num_shots);
+}
+
+static BenchmarkResult &bench_sample(const Circuit &circuit, size_t num_shots) {
+    FILE *out = tmpfile();
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    auto ref = TableauSimulator::reference_sample_circuit(circuit);
+    auto &result = benchmark_go([&]() {
+        rewind(out);
+        FrameSimulator::sample_out(circuit, ref, num_shots, out, SAMPLE_FORMAT_B8, rng);
+    });
+    fclose(out);
+    return result.show_rate("Samples", (double)circuit.count_measurements() * num_shots);
+}
+
+static BenchmarkResult &bench_analyze(const Circuit &circuit, bool decompose_errors, bool fold_loops) {
+    return benchmark_go([&]() {
+        ErrorAnalyzer::circuit_to_detector_error_model(circuit, decompose_errors, fold_loops, false, 0.0);
+    });
+}
+
+static BenchmarkResult &bench_write(SampleFormat format, size_t num_shots, size_t num_dets) {
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    simd_bit_table table(num_dets, num_shots);
+    // Detection events are sparse.
+    for (size_t k = 0; k < num_dets; k++) {
+        table[k][rng() % num_shots] = true;
+    }
+    simd_bits ref(0);
+    FILE *out = tmpfile();
+    auto &result = benchmark_go([&]() {
+        rewind(out);
+        write_table_data(out, num_shots, num_dets, ref, table, format, 'D', 'L', num_dets);
+    });
+    fclose(out);
+    return result.show_rate("Dets", (double)num_dets * num_shots);
+}
+
+BENCHMARK(gen_detect1024_rep_d3_r10) {
+    auto circuit = gen_circuit("memory", 3, 10);
+    bench_detect(circuit, 1024).goal_micros(150);
+}
+
+BENCHMARK(gen_detect1024_rep_d31_r10000) {
+    auto circuit = gen_circuit("memory", 31, 10000);
+    bench_detect(circuit, 1024).goal_millis(360);
+}
+
+BENCHMARK(gen_detect1024_surface_rotated_memory_z_d11_r100) {
+    auto circuit = gen_circuit("rotated_memory_z", 11, 100);
+    bench_detect(circuit, 1024).goal_millis(8);
+}
+
+BENCHMARK(gen_detect1024_surface_rotated_memory_z_d31_r100) {
+    auto circuit = gen_circuit("rotated_memory_z", 31, 100);
+    bench_detect(circuit, 1024).goal_millis(90);
+}
+
+BENCHMARK(gen_detect1024_surface_unrotated_memory_x_d11_r1000) {
+    auto circuit = gen_circuit("unrotated_memory_x", 11, 1000);
+    bench_detect(circuit, 1024).goal_millis(340);
+}
+
+BENCHMARK(gen_detect1024_color_memory_xyz_d11_r100) {
+    auto circuit = gen_circuit("memory_xyz", 11, 100);
+    bench_detect(circuit, 1024).goal_millis(4);
+}
+
+BENCHMARK(gen_sample1024_surface_rotated_memory_x_d11_r100) {
+    auto circuit = gen_circuit("rotated_memory_x", 11, 100);
+    bench_sample(circuit, 1024).goal_millis(7);
+}
+
+BENCHMARK(gen_sample1024_color_memory_xyz_d31_r10) {
+    auto circuit = gen_circuit("memory_xyz", 31, 10);
+    bench_sample(circuit, 1024).goal_millis(4);
+}
+
+BENCHMARK(gen_analyze_errors_surface_rotated_memory_z_d31_r10) {
+    auto circuit = gen_circuit("rotated_memory_z", 31, 10);
+    bench_analyze(circuit, false, false).goal_millis(480);
+}
+
+BENCHMARK(gen_analyze_errors_decompose_surface_rotated_memory_z_d31_r10) {
+    auto circuit = gen_circuit("rotated_memory_z", 31, 10);
+    bench_analyze(circuit, true, false).goal_millis(700);
+}
+
+BENCHMARK(gen_analyze_errors_fold_surface_rotated_memory_z_d11_r10000) {
+    auto circuit = gen_circuit("rotated_memory_z", 11, 10000);
+    bench_analyze(circuit, false, true).goal_millis(18);
+}
+
+BENCHMARK(gen_analyze_errors_fold_decompose_surface_rotated_memory_x_d11_r10000) {
+    auto circuit = gen_circuit("rotated_memory_x", 11, 10000);
+    bench_analyze(circuit, true, true).goal_millis(26);
+}
+
+BENCHMARK(gen_analyze_errors_fold_color_memory_xyz_d11_r10000) {
+    auto circuit = gen_circuit("memory_xyz", 11, 10000);
+    bench_analyze(circuit, false, true).goal_millis(17);
+}
+
+BENCHMARK(gen_analyze_errors_fold_rep_d31_r10000) {
+    auto circuit = gen_circuit("memory", 31, 10000);
+    bench_analyze(circuit, false, true).goal_micros(600);
+}
+
+BENCHMARK(gen_parse_surface_rotated_memory_z_d31_r100) {
+    auto text = gen_circuit("rotated_memory_z", 31, 100).str();
+    benchmark_go([&]() {
+        Circuit parsed(text.data());
+    })
+        .goal_micros(900)
+        .show_rate("Bytes", text.size());
+}
+
+BENCHMARK(gen_parse_flattened_surface_rotated_memory_z_d11_r100) {
+    auto text = flattened_text(gen_circuit("rotated_memory_z", 11, 100));
+    benchmark_go([&]() {
+        Circuit parsed(text.data());
+    })
+        .goal_millis(4)
+        .show_rate("Bytes", text.size());
+}
+
+BENCHMARK(gen_str_surface_rotated_memory_z_d31_r100) {
+    auto circuit = gen_circuit("rotated_memory_z", 31, 100);
+    size_t total = 0;
+    benchmark_go([&]() {
+        total += circuit.str().size();
+    }).goal_millis(2);
+    if (total == 0) {
+        std::cout << "data dependence";
+    }
+}
+
+BENCHMARK(gen_write_dets_01_shots1024_dets100K) {
+    bench_write(SAMPLE_FORMAT_01, 1024, 100000).goal_millis(500);
+}
+
+BENCHMARK(gen_write_dets_b8_shots1024_dets100K) {
+    bench_write(SAMPLE_FORMAT_B8, 1024, 100000).goal_millis(25);
+}
+
+BENCHMARK(gen_write_dets_ptb64_shots1024_dets100K) {
+    bench_write(SAMPLE_FORMAT_PTB64, 1024, 100000).goal_millis(40);
+}
+
+BENCHMARK(gen_write_dets_hits_shots1024_dets100K) {
+    bench_write(SAMPLE_FORMAT_HITS, 1024, 100000).goal_millis(45);
+}
+
+BENCHMARK(gen_write_dets_dets_shots1024_dets100K) {
+    bench_write(SAMPLE_FORMAT_DETS, 1024, 100000).goal_millis(40);
+}
@@ -30,6 +30,7 @@
 #include "../io/measure_record_batch.h"
 #include "../io/measure_record_batch_writer.h"
 #include "../io/measure_record_writer.h"
+#include "../memory_budget.h"
 #include "../probability_util.h"
 #include "../simd/bit_ref.h"
 #include "../simd/simd_bit_table.h"
@@ -39,11 +40,14 @@
 #include "../simd/simd_util.h"
 #include "../simd/sparse_xor_vec.h"
 #include "../simulators/detection_simulator.h"
+#include "../simulators/detector_xor_program.h"
 #include "../simulators/error_analyzer.h"
 #include "../simulators/frame_simulator.h"
 #include "../simulators/tableau_simulator.h"
 #include "../simulators/vector_simulator.h"
+#include "../simulators/zx_graph_solver.h"
 #include "../stabilizers/pauli_string.h"
+#include "../stabilizers/pauli_string_batch.h"
 #include "../stabilizers/pauli_string_ref.h"
 #include "../stabilizers/tableau.h"
 #include "../stabilizers/tableau_transposed_raii.h"
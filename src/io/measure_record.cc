@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "measure_record_writer.h"
+#include "../profiling.h"
 
 using namespace stim_internal;
 
@@ -26,6 +27,8 @@ MeasureRecord::MeasureRecord(size_t max_lookback) : max_lookback(max_lookback),
 }
 
 void MeasureRecord::write_unwritten_results_to(MeasureRecordWriter &writer) {
+    ProfileScope profile_scope(GLOBAL_PROFILER.writers);
+    profile_scope.add_bytes((unwritten + 7) >> 3);
     size_t n = storage.size();
     for (size_t k = n - unwritten; k < n; k++) {
         writer.write_bit(storage[k]);
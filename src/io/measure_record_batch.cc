@@ -39,9 +39,13 @@ void MeasureRecordBatch::reserve_space_for_results(size_t count) {
 }
 
 void MeasureRecordBatch::reserve_noisy_space_for_results(const OperationData &target_data, std::mt19937_64 &rng) {
-    size_t count = target_data.targets.size();
+    reserve_noisy_space_for_results(target_data.targets.size(), target_data.args, rng);
+}
+
+void MeasureRecordBatch::reserve_noisy_space_for_results(
+    size_t count, ConstPointerRange<double> args, std::mt19937_64 &rng) {
     reserve_space_for_results(count);
-    float p = target_data.args.empty() ? 0 : target_data.args[0];
+    float p = args.empty() ? 0 : args[0];
     biased_randomize_bits(p, storage[stored].u64, storage[stored + count].u64, rng);
 }
 
@@ -66,6 +66,8 @@ struct MeasureRecordBatch {
     void record_result(simd_bits_range_ref result);
     /// Reserves space for storing measurement results. Initializes bits to be noisy with the given probability.
     void reserve_noisy_space_for_results(const OperationData &target_data, std::mt19937_64 &rng);
+    /// Reserves space for a number of results that differs from the operation's number of targets (e.g. for MPP).
+    void reserve_noisy_space_for_results(size_t count, ConstPointerRange<double> args, std::mt19937_64 &rng);
     /// Ensures there is enough space for storing a number of measurement results, without moving memory.
     void reserve_space_for_results(size_t count);
     /// Resets the record to an empty state.
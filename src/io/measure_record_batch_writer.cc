@@ -19,12 +19,14 @@
 #include <algorithm>
 
 #include "measure_record_batch.h"
+#include "../memory_budget.h"
+#include "../profiling.h"
 
 using namespace stim_internal;
 
 MeasureRecordBatchWriter::MeasureRecordBatchWriter(FILE *out, size_t num_shots, SampleFormat output_format)
     : output_format(output_format), out(out) {
-    if (num_shots > 768) {
+    if (num_shots > MAX_SHOT_BATCH_SIZE) {
         throw std::out_of_range("num_shots > 768 (safety check to ensure staying away from linux file handle limit)");
     }
     auto f = output_format;
@@ -37,13 +39,23 @@ MeasureRecordBatchWriter::MeasureRecordBatchWriter(FILE *out, size_t num_shots,
     if (s) {
         writers.push_back(MeasureRecordWriter::make(out, f));
     }
+    size_t buffer_size = memory_limited_file_buffer_size(s ? s - 1 : 0);
     for (size_t k = 1; k < s; k++) {
         FILE *file = tmpfile();
         if (file == nullptr) {
             throw std::out_of_range("Failed to open a temp file.");
         }
-        writers.push_back(MeasureRecordWriter::make(file, f));
         temporary_files.push_back(file);
+        if (memory_limit_is_set()) {
+            // The C library may ignore the requested size of a buffer it allocates itself, so the buffer is owned here.
+            if (buffer_size == 0) {
+                setvbuf(file, nullptr, _IONBF, 0);
+            } else {
+                temporary_file_buffers.emplace_back(buffer_size);
+                setvbuf(file, temporary_file_buffers.back().data(), _IOFBF, buffer_size);
+            }
+        }
+        writers.push_back(MeasureRecordWriter::make(file, f));
     }
 }
 
@@ -61,6 +73,8 @@ void MeasureRecordBatchWriter::begin_result_type(char result_type) {
 }
 
 void MeasureRecordBatchWriter::batch_write_bit(simd_bits_range_ref bits) {
+    ProfileScope profile_scope(GLOBAL_PROFILER.writers);
+    profile_scope.add_bytes(bits.num_u8_padded());
     if (output_format == SAMPLE_FORMAT_PTB64) {
         uint8_t *p = bits.u8;
         for (auto &writer : writers) {
@@ -76,10 +90,14 @@ void MeasureRecordBatchWriter::batch_write_bit(simd_bits_range_ref bits) {
 }
 
 void MeasureRecordBatchWriter::batch_write_bytes(const simd_bit_table &table, size_t num_major_u64) {
+    ProfileScope profile_scope(GLOBAL_PROFILER.writers);
+    profile_scope.add_bytes(table.data.num_u8_padded());
     if (output_format == SAMPLE_FORMAT_PTB64) {
+        // Each writer handles a group of 64 shots, and gets 8 bytes from every major row.
+        size_t num_major_bits = num_major_u64 << 6;
         for (size_t k = 0; k < writers.size(); k++) {
-            for (size_t w = 0; w < num_major_u64; w++) {
-                uint8_t *p = table.data.u8 + (k * 8) + table.num_minor_u8_padded() * w;
+            for (size_t m = 0; m < num_major_bits; m++) {
+                uint8_t *p = table.data.u8 + (k * 8) + table.num_minor_u8_padded() * m;
                 writers[k]->write_bytes({p, p + 8});
             }
         }
@@ -93,6 +111,7 @@ void MeasureRecordBatchWriter::batch_write_bytes(const simd_bit_table &table, si
 }
 
 void MeasureRecordBatchWriter::write_end() {
+    ProfileScope profile_scope(GLOBAL_PROFILER.writers);
     for (auto &writer : writers) {
         writer->write_end();
     }
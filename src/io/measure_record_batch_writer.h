@@ -28,6 +28,8 @@ struct MeasureRecordBatchWriter {
     FILE *out;
     /// Temporary files used to hold data that will eventually be concatenated onto the main stream.
     std::vector<FILE *> temporary_files;
+    /// Buffers given to the temporary files when an explicit memory limit is set. Released after the files are closed.
+    std::vector<std::vector<char>> temporary_file_buffers;
     /// The individual writers for each incoming stream of measurement results.
     /// The first writer will go directly to `out`, whereas the others go into temporary files.
     std::vector<std::unique_ptr<MeasureRecordWriter>> writers;
@@ -18,6 +18,7 @@
 
 #include "gtest/gtest.h"
 
+#include "../memory_budget.h"
 #include "../test_util.test.h"
 
 using namespace stim_internal;
@@ -41,3 +42,18 @@ TEST(MeasureRecordBatchWriter, basic_usage) {
     ASSERT_EQ(getc(tmp), '0');
     ASSERT_EQ(getc(tmp), '\n');
 }
+
+TEST(MeasureRecordBatchWriter, file_buffers_follow_memory_limit) {
+    simd_bits v(5);
+    v[1] = true;
+    for (uint64_t limit : {uint64_t{0}, uint64_t{1}, uint64_t{1} << 20}) {
+        set_memory_limit_bytes(limit);
+        FILE *tmp = tmpfile();
+        MeasureRecordBatchWriter w(tmp, 5, SAMPLE_FORMAT_01);
+        ASSERT_EQ(w.temporary_file_buffers.size(), limit > 1 ? 4 : 0) << limit;
+        w.batch_write_bit(v);
+        w.write_end();
+        ASSERT_EQ(rewind_read_all(tmp), "0\n1\n0\n0\n0\n") << limit;
+    }
+    set_memory_limit_bytes(0);
+}
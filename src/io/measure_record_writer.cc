@@ -18,6 +18,8 @@
 
 #include <algorithm>
 
+#include "../profiling.h"
+
 using namespace stim_internal;
 
 std::unique_ptr<MeasureRecordWriter> MeasureRecordWriter::make(FILE *out, SampleFormat output_format) {
@@ -214,6 +216,8 @@ void stim_internal::write_table_data(
     char dets_prefix_1,
     char dets_prefix_2,
     size_t dets_prefix_transition) {
+    ProfileScope profile_scope(GLOBAL_PROFILER.writers);
+    profile_scope.add_bytes(table.data.num_u8_padded());
     if (format == SAMPLE_FORMAT_PTB64) {
         auto f64 = num_shots >> 6;
         for (size_t s = 0; s < f64; s++) {
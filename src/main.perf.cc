@@ -90,6 +90,67 @@ BENCHMARK(main_sample1_pauliframe_b8_rep_d1000_r100) {
         .show_rate("Samples", circuit.count_measurements());
 }
 
+BENCHMARK(main_sample1_pauliframe_with_reference_b8_rep_d1000_r100) {
+    size_t distance = 1000;
+    size_t rounds = 100;
+    auto circuit = make_rep_code(distance, rounds);
+    FILE *out = tmpfile();
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    benchmark_go([&]() {
+        rewind(out);
+        auto ref = TableauSimulator::reference_sample_circuit(circuit);
+        FrameSimulator::sample_out(circuit, ref, 1, out, SAMPLE_FORMAT_B8, rng);
+    })
+        .goal_millis(45)
+        .show_rate("Samples", circuit.count_measurements());
+}
+
+BENCHMARK(main_sample8_tableau_b8_rep_d1000_r100) {
+    size_t distance = 1000;
+    size_t rounds = 100;
+    auto circuit = make_rep_code(distance, rounds);
+    FILE *out = tmpfile();
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    benchmark_go([&]() {
+        rewind(out);
+        for (size_t k = 0; k < 8; k++) {
+            auto sample = TableauSimulator::sample_circuit(circuit, rng);
+            fwrite(sample.u8, 1, (circuit.count_measurements() + 7) >> 3, out);
+        }
+    })
+        .goal_millis(240)
+        .show_rate("Samples", circuit.count_measurements() * 8);
+}
+
+BENCHMARK(main_sample8_pauliframe_with_reference_b8_rep_d1000_r100) {
+    size_t distance = 1000;
+    size_t rounds = 100;
+    auto circuit = make_rep_code(distance, rounds);
+    FILE *out = tmpfile();
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    benchmark_go([&]() {
+        rewind(out);
+        auto ref = TableauSimulator::reference_sample_circuit(circuit);
+        FrameSimulator::sample_out(circuit, ref, 8, out, SAMPLE_FORMAT_B8, rng);
+    })
+        .goal_millis(45)
+        .show_rate("Samples", circuit.count_measurements() * 8);
+}
+
+BENCHMARK(main_sample8_cost_model_b8_rep_d1000_r100) {
+    size_t distance = 1000;
+    size_t rounds = 100;
+    auto circuit = make_rep_code(distance, rounds);
+    FILE *out = tmpfile();
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    benchmark_go([&]() {
+        rewind(out);
+        sample_measurements_out(circuit, 8, false, out, SAMPLE_FORMAT_B8, rng);
+    })
+        .goal_millis(45)
+        .show_rate("Samples", circuit.count_measurements() * 8);
+}
+
 BENCHMARK(main_sample1_detectors_b8_rep_d1000_r100) {
     size_t distance = 1000;
     size_t rounds = 100;
@@ -14,11 +14,19 @@
 
 #include "main_helper.h"
 
+#include <atomic>
+#include <functional>
+#include <map>
+#include <thread>
+
 #include "arg_parse.h"
 #include "gate_help.h"
 #include "gen/circuit_gen_main.h"
+#include "memory_budget.h"
 #include "probability_util.h"
+#include "profiling.h"
 #include "simulators/detection_simulator.h"
+#include "simulators/detector_xor_program.h"
 #include "simulators/error_analyzer.h"
 #include "simulators/frame_simulator.h"
 #include "simulators/tableau_simulator.h"
@@ -34,9 +42,137 @@ static std::map<std::string, SampleFormat> format_name_to_enum_map{
     {"dets", SAMPLE_FORMAT_DETS},
 };
 
+/// Adds the circuit generation arguments to a mode's known arguments, when the circuit is being generated.
+std::vector<const char *> with_gen_arguments(std::vector<const char *> known, int argc, const char **argv) {
+    if (find_argument("--gen", argc, argv) != nullptr) {
+        const auto &gen = circuit_gen_known_arguments();
+        known.insert(known.end(), gen.begin(), gen.end());
+        known.push_back("--threads");
+    }
+    return known;
+}
+
+/// Runs a mode on each circuit in a circuit generation sweep, using a pool of `--threads` threads.
+///
+/// The mode is given the parameters of each point along with its generated circuit. Each point's results are written
+/// to `out` in sweep order (regardless of the order the threads finish in), preceded by a `# sweep: ...` comment line
+/// describing the parameters of the point.
+void run_gen_sweep(
+    FILE *out,
+    int argc,
+    const char **argv,
+    const std::function<void(const CircuitGenParameters &point, const Circuit &circuit, FILE *point_out)> &run) {
+    if (find_argument("--in", argc, argv) != nullptr) {
+        throw std::invalid_argument("Can't specify both `--gen` and `--in`.");
+    }
+    auto points = circuit_gen_sweep_from_args(argc, argv);
+    size_t default_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t num_threads = (size_t)find_int64_argument("--threads", default_threads, 1, 4096, argc, argv);
+    if (GLOBAL_PROFILER.enabled) {
+        // The profiler isn't thread safe.
+        num_threads = 1;
+    }
+
+    // Each point writes into its own temporary file, so outputs can be large without being held in memory.
+    std::vector<FILE *> point_outs(points.size(), nullptr);
+    std::vector<std::exception_ptr> point_errors(points.size());
+    std::atomic<size_t> next_point{0};
+    auto worker = [&]() {
+        while (true) {
+            size_t k = next_point++;
+            if (k >= points.size()) {
+                break;
+            }
+            point_outs[k] = tmpfile();
+            try {
+                if (point_outs[k] == nullptr) {
+                    throw std::runtime_error("Failed to open a temporary file for sweep results.");
+                }
+                run(points[k], generate_circuit_from_args(argc, argv, points[k]).circuit, point_outs[k]);
+            } catch (...) {
+                point_errors[k] = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < std::min(num_threads, points.size()); t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::exception_ptr first_error = nullptr;
+    for (size_t k = 0; k < points.size(); k++) {
+        if (point_errors[k] != nullptr) {
+            first_error = first_error == nullptr ? point_errors[k] : first_error;
+        } else if (first_error == nullptr) {
+            fprintf(out, "# sweep: %s\n", points[k].str().data());
+            rewind(point_outs[k]);
+            char buf[1 << 14];
+            size_t n;
+            while ((n = fread(buf, 1, sizeof(buf), point_outs[k])) > 0) {
+                fwrite(buf, 1, n, out);
+            }
+        }
+        if (point_outs[k] != nullptr) {
+            fclose(point_outs[k]);
+        }
+    }
+    if (first_error != nullptr) {
+        std::rethrow_exception(first_error);
+    }
+}
+
+/// Describes the parameters of a sweep point that determine the structure of its circuit.
+///
+/// The noise parameters only add noise channels to the generated circuit, so points that differ only in noise have
+/// the same measurements and detectors.
+std::string sweep_structure_key(const CircuitGenParameters &point) {
+    return CircuitGenParameters(point.rounds, point.distance, point.task).str();
+}
+
+/// Determines if the circuit generation arguments describe more than one circuit.
+bool is_gen_sweep(int argc, const char **argv) {
+    return find_argument("--gen", argc, argv) != nullptr && circuit_gen_sweep_from_args(argc, argv).size() > 1;
+}
+
+/// Reads the input circuit from `--in` (default stdin), or generates it in-process when `--gen` is given.
+Circuit read_or_generate_circuit(int argc, const char **argv) {
+    if (find_argument("--gen", argc, argv) != nullptr) {
+        if (find_argument("--in", argc, argv) != nullptr) {
+            throw std::invalid_argument("Can't specify both `--gen` and `--in`.");
+        }
+        if (is_gen_sweep(argc, argv)) {
+            throw std::invalid_argument(
+                "Sweeping over generated circuits is only supported by --detect and --analyze_errors.");
+        }
+        return generate_circuit_from_args(argc, argv).circuit;
+    }
+    FILE *in = find_open_file_argument("--in", stdin, "r", argc, argv);
+    auto circuit = Circuit::from_file(in);
+    if (in != stdin) {
+        fclose(in);
+    }
+    return circuit;
+}
+
 int main_mode_detect(int argc, const char **argv) {
     check_for_unknown_arguments(
-        {"--detect", "--prepend_observables", "--append_observables", "--out_format", "--out", "--in"},
+        with_gen_arguments(
+            {
+                "--detect",
+                "--prepend_observables",
+                "--append_observables",
+                "--out_format",
+                "--out",
+                "--in",
+                "--profile",
+                "--memory_limit",
+            },
+            argc,
+            argv),
         "--detect",
         argc,
         argv);
@@ -51,12 +187,40 @@ int main_mode_detect(int argc, const char **argv) {
         prepend_observables = true;
     }
 
-    FILE *in = find_open_file_argument("--in", stdin, "r", argc, argv);
-    FILE *out = find_open_file_argument("--out", stdout, "w", argc, argv);
-    auto circuit = Circuit::from_file(in);
-    if (in != stdin) {
-        fclose(in);
+    if (is_gen_sweep(argc, argv)) {
+        if (out_format != SAMPLE_FORMAT_01 && out_format != SAMPLE_FORMAT_HITS && out_format != SAMPLE_FORMAT_DETS) {
+            throw std::invalid_argument("Sweeps interleave results with comment lines, so need a text --out_format.");
+        }
+        // The detector program only depends on the circuit's structure, so it's compiled once per structure instead
+        // of once per noise value.
+        std::map<std::string, DetectorXorProgram> programs;
+        for (const auto &point : circuit_gen_sweep_from_args(argc, argv)) {
+            auto key = sweep_structure_key(point);
+            if (programs.find(key) == programs.end()) {
+                programs.emplace(key, DetectorXorProgram(generate_circuit_from_args(argc, argv, point).circuit));
+            }
+        }
+        FILE *out = find_open_file_argument("--out", stdout, "w", argc, argv);
+        run_gen_sweep(out, argc, argv, [&](const CircuitGenParameters &point, const Circuit &circuit, FILE *point_out) {
+            auto rng = externally_seeded_rng();
+            detector_samples_out(
+                circuit,
+                programs.at(sweep_structure_key(point)),
+                num_shots,
+                prepend_observables,
+                append_observables,
+                point_out,
+                out_format,
+                rng);
+        });
+        if (out != stdout) {
+            fclose(out);
+        }
+        return EXIT_SUCCESS;
     }
+
+    auto circuit = read_or_generate_circuit(argc, argv);
+    FILE *out = find_open_file_argument("--out", stdout, "w", argc, argv);
     auto rng = externally_seeded_rng();
     detector_samples_out(circuit, num_shots, prepend_observables, append_observables, out, out_format, rng);
     if (out != stdout) {
@@ -65,29 +229,93 @@ int main_mode_detect(int argc, const char **argv) {
     return EXIT_SUCCESS;
 }
 
+bool stim_internal::prefer_tableau_sampling(const Circuit &circuit, uint64_t num_shots) {
+    // Costs are rough counts of simd word operations.
+    constexpr uint64_t BITS_PER_WORD = sizeof(simd_word) << 3;
+    constexpr uint64_t OVERHEAD_PER_TARGET = 4;
+    uint64_t n = circuit.count_qubits();
+    uint64_t qubit_words = (n + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    uint64_t shot_words = (num_shots + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    auto r = gate_name_to_id("R");
+    auto rx = gate_name_to_id("RX");
+    auto ry = gate_name_to_id("RY");
+
+    // Unitary and noise operations touch a couple of rows in each half of the tableau. Measurements and resets are
+    // pessimistically assumed to be random, which means transposing the tableau and doing Gaussian elimination.
+    uint64_t tableau_cost_per_shot = circuit.flat_count_operations([&](const Operation &op) -> uint64_t {
+        uint64_t k = op.target_data.targets.size();
+        if ((op.gate->flags & GATE_PRODUCES_NOISY_RESULTS) || op.gate->id == r || op.gate->id == rx ||
+            op.gate->id == ry) {
+            return 8 * n * qubit_words + k * (n * qubit_words + OVERHEAD_PER_TARGET);
+        }
+        return k * (4 * qubit_words + OVERHEAD_PER_TARGET);
+    });
+
+    // Each target is one pass over the shot words, and the measurement data has to be transposed for output.
+    uint64_t frame_cost = circuit.flat_count_operations([&](const Operation &op) -> uint64_t {
+        return op.target_data.targets.size() * (shot_words + OVERHEAD_PER_TARGET);
+    });
+    frame_cost = add_saturate(frame_cost, mul_saturate(circuit.count_measurements(), shot_words));
+    // Getting the reference sample costs one tableau simulation.
+    frame_cost = add_saturate(frame_cost, tableau_cost_per_shot);
+
+    return mul_saturate(tableau_cost_per_shot, num_shots) <= frame_cost;
+}
+
+void stim_internal::sample_measurements_out(
+    const Circuit &circuit, uint64_t num_shots, bool frame0, FILE *out, SampleFormat format, std::mt19937_64 &rng) {
+    if (num_shots == 0) {
+        return;
+    }
+
+    if (!frame0 && format != SAMPLE_FORMAT_PTB64 && prefer_tableau_sampling(circuit, num_shots)) {
+        for (uint64_t k = 0; k < num_shots; k++) {
+            auto writer = MeasureRecordWriter::make(out, format);
+            writer->begin_result_type('M');
+            auto sample = TableauSimulator::sample_circuit(circuit, rng);
+            size_t num_measurements = circuit.count_measurements();
+            for (size_t m = 0; m < num_measurements; m++) {
+                writer->write_bit(sample[m]);
+            }
+            writer->write_end();
+        }
+        return;
+    }
+
+    simd_bits ref(0);
+    if (!frame0) {
+        ref = TableauSimulator::reference_sample_circuit(circuit);
+    }
+    FrameSimulator::sample_out(circuit, ref, num_shots, out, format, rng);
+}
+
 int main_mode_sample(int argc, const char **argv) {
-    check_for_unknown_arguments({"--sample", "--frame0", "--out_format", "--out", "--in"}, "--sample", argc, argv);
+    check_for_unknown_arguments(
+        with_gen_arguments(
+            {"--sample", "--frame0", "--out_format", "--out", "--in", "--profile", "--memory_limit"}, argc, argv),
+        "--sample",
+        argc,
+        argv);
     SampleFormat out_format = find_enum_argument("--out_format", "01", format_name_to_enum_map, argc, argv);
     bool frame0 = find_bool_argument("--frame0", argc, argv);
     uint64_t num_shots = (uint64_t)find_int64_argument("--sample", 1, 0, INT64_MAX, argc, argv);
-    FILE *in = find_open_file_argument("--in", stdin, "r", argc, argv);
+    bool generate = find_argument("--gen", argc, argv) != nullptr;
     FILE *out = find_open_file_argument("--out", stdout, "w", argc, argv);
     auto rng = externally_seeded_rng();
 
-    if (num_shots == 1 && !frame0) {
+    if (num_shots == 1 && !frame0 && !generate) {
+        // Getting a reference sample costs as much as a tableau simulation, so for a single shot the tableau
+        // simulator always wins. Stream it, so the circuit never has to be held in memory.
+        FILE *in = find_open_file_argument("--in", stdin, "r", argc, argv);
         TableauSimulator::sample_stream(in, out, out_format, false, rng);
-    } else if (num_shots > 0) {
-        auto circuit = Circuit::from_file(in);
-        simd_bits ref(0);
-        if (!frame0) {
-            ref = TableauSimulator::reference_sample_circuit(circuit);
+        if (in != stdin) {
+            fclose(in);
         }
-        FrameSimulator::sample_out(circuit, ref, num_shots, out, out_format, rng);
+    } else if (num_shots > 0) {
+        auto circuit = read_or_generate_circuit(argc, argv);
+        sample_measurements_out(circuit, num_shots, frame0, out, out_format, rng);
     }
 
-    if (in != stdin) {
-        fclose(in);
-    }
     if (out != stdout) {
         fclose(out);
     }
@@ -96,16 +324,20 @@ int main_mode_sample(int argc, const char **argv) {
 
 int main_mode_analyze_errors(int argc, const char **argv) {
     check_for_unknown_arguments(
-        {
-            "--allow_gauge_detectors",
-            "--analyze_errors",
-            "--approximate_disjoint_errors",
-            "--detector_hypergraph",
-            "--decompose_errors",
-            "--fold_loops",
-            "--out",
-            "--in",
-        },
+        with_gen_arguments(
+            {
+                "--allow_gauge_detectors",
+                "--analyze_errors",
+                "--approximate_disjoint_errors",
+                "--detector_hypergraph",
+                "--decompose_errors",
+                "--fold_loops",
+                "--out",
+                "--in",
+                "--profile",
+            },
+            argc,
+            argv),
         "--analyze_errors",
         argc,
         argv);
@@ -122,21 +354,30 @@ int main_mode_analyze_errors(int argc, const char **argv) {
             find_float_argument("--approximate_disjoint_errors", 0, 0, 1, argc, argv);
     }
 
-    FILE *in = find_open_file_argument("--in", stdin, "r", argc, argv);
+    auto analyze = [&](const Circuit &circuit) {
+        return ErrorAnalyzer::circuit_to_detector_error_model(
+            circuit, decompose_errors, fold_loops, allow_gauge_detectors, approximate_disjoint_errors_threshold);
+    };
+    if (is_gen_sweep(argc, argv)) {
+        FILE *out = find_open_file_argument("--out", stdout, "w", argc, argv);
+        run_gen_sweep(out, argc, argv, [&](const CircuitGenParameters &, const Circuit &circuit, FILE *point_out) {
+            fprintf(point_out, "%s\n", analyze(circuit).str().data());
+        });
+        if (out != stdout) {
+            fclose(out);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    auto circuit = read_or_generate_circuit(argc, argv);
     auto out_stream = find_output_stream_argument("--out", true, argc, argv);
     std::ostream &out = out_stream.stream();
-    auto circuit = Circuit::from_file(in);
-    if (in != stdin) {
-        fclose(in);
-    }
-    out << ErrorAnalyzer::circuit_to_detector_error_model(
-               circuit, decompose_errors, fold_loops, allow_gauge_detectors, approximate_disjoint_errors_threshold)
-        << "\n";
+    out << analyze(circuit) << "\n";
     return EXIT_SUCCESS;
 }
 
 int main_mode_repl(int argc, const char **argv) {
-    check_for_unknown_arguments({"--repl"}, "--repl", argc, argv);
+    check_for_unknown_arguments({"--repl", "--profile"}, "--repl", argc, argv);
     auto rng = externally_seeded_rng();
     TableauSimulator::sample_stream(stdin, stdout, SAMPLE_FORMAT_01, true, rng);
     return EXIT_SUCCESS;
@@ -158,7 +399,11 @@ int stim_internal::main_helper(int argc, const char **argv) {
         std::cerr << "[DEPRECATION] Use `--analyze_errors` instead of `--detector_hypergraph`\n";
         mode_analyze_errors = true;
     }
-    if (mode_repl + mode_sample + mode_detect + mode_analyze_errors + mode_gen != 1) {
+    int num_consumer_modes = mode_repl + mode_sample + mode_detect + mode_analyze_errors;
+    if (mode_gen && num_consumer_modes == 0) {
+        return main_generate_circuit(argc, argv);
+    }
+    if (num_consumer_modes != 1 || (mode_gen && mode_repl)) {
         std::cerr << "\033[31m"
                      "Need to pick a mode by giving exactly one of the following command line arguments:\n"
                      "    --repl: Interactive mode. Eagerly sample measurements in input circuit.\n"
@@ -166,25 +411,43 @@ int stim_internal::main_helper(int argc, const char **argv) {
                      "    --detect #: Detector sampling mode. Bulk sample detection events from input circuit.\n"
                      "    --analyze_errors: Error analysis mode. Convert circuit into a detector error model.\n"
                      "    --gen: Circuit generation mode. Produce common error correction circuits.\n"
+                     "(--gen can also be combined with --sample, --detect, or --analyze_errors to use the generated\n"
+                     "circuit as the input circuit.)\n"
                      "\033[0m";
         return EXIT_FAILURE;
     }
 
-    if (mode_gen) {
-        return main_generate_circuit(argc, argv);
+    bool profile = find_bool_argument("--profile", argc, argv);
+    if (profile) {
+        GLOBAL_PROFILER.clear();
+        GLOBAL_PROFILER.enabled = true;
     }
-    if (mode_repl) {
-        return main_mode_repl(argc, argv);
+    const char *memory_limit_arg = find_argument("--memory_limit", argc, argv);
+    // A limit of 0 restores the default, leaving no limit explicitly set.
+    uint64_t old_memory_limit = memory_limit_is_set() ? memory_limit_bytes() : 0;
+    if (memory_limit_arg != nullptr) {
+        set_memory_limit_bytes(parse_memory_size(memory_limit_arg));
     }
-    if (mode_sample) {
-        return main_mode_sample(argc, argv);
+    int result;
+    if (mode_repl) {
+        result = main_mode_repl(argc, argv);
+    } else if (mode_sample) {
+        result = main_mode_sample(argc, argv);
+    } else if (mode_detect) {
+        result = main_mode_detect(argc, argv);
+    } else if (mode_analyze_errors) {
+        result = main_mode_analyze_errors(argc, argv);
+    } else {
+        throw std::out_of_range("Mode not handled.");
     }
-    if (mode_detect) {
-        return main_mode_detect(argc, argv);
+    if (profile) {
+        GLOBAL_PROFILER.enabled = false;
+        std::cerr << GLOBAL_PROFILER.str();
     }
-    if (mode_analyze_errors) {
-        return main_mode_analyze_errors(argc, argv);
+    if (memory_limit_arg != nullptr) {
+        std::cerr << "Peak memory usage: " << describe_memory_size(peak_memory_usage_bytes()) << " (memory limit "
+                  << describe_memory_size(memory_limit_bytes()) << ")\n";
+        set_memory_limit_bytes(old_memory_limit);
     }
-
-    throw std::out_of_range("Mode not handled.");
+    return result;
 }
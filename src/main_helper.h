@@ -26,6 +26,29 @@ namespace stim_internal {
 
 int main_helper(int argc, const char **argv);
 
+/// Estimates whether measurement samples are cheaper to produce by running a tableau simulation for each shot, instead
+/// of getting a reference sample and then running a batched frame simulation over all of the shots.
+///
+/// Args:
+///     circuit: The circuit to sample.
+///     num_shots: The number of samples that will be taken.
+///
+/// Returns:
+///     True if the tableau simulator is expected to be faster.
+bool prefer_tableau_sampling(const Circuit &circuit, uint64_t num_shots);
+
+/// Samples measurements from a circuit, using whichever of tableau simulation and frame simulation is cheaper.
+///
+/// Args:
+///     circuit: The circuit to sample.
+///     num_shots: The number of samples to take.
+///     frame0: When set, measurement flips relative to an all-zero reference sample are written instead of samples.
+///     out: Where to write the samples.
+///     format: The format to write the samples in.
+///     rng: Random number generator to use.
+void sample_measurements_out(
+    const Circuit &circuit, uint64_t num_shots, bool frame0, FILE *out, SampleFormat format, std::mt19937_64 &rng);
+
 }
 
 #endif
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include <regex>
 
+#include "memory_budget.h"
 #include "test_util.test.h"
 
 using namespace stim_internal;
@@ -186,6 +187,56 @@ M !0
             )output"));
 }
 
+TEST(main_helper, memory_limit_flag) {
+    auto result = execute({"--detect=3", "--memory_limit=1K", "--prepend_observables"}, R"input(
+X_ERROR(1) 0
+M 0 1
+DETECTOR rec[-2]
+DETECTOR rec[-1]
+OBSERVABLE_INCLUDE(0) rec[-2]
+    )input");
+    ASSERT_TRUE(matches(result, ".*stderr=Peak memory usage: .* [KMG]iB \\(memory limit 1.0 KiB\\)\n.*")) << result;
+    ASSERT_EQ(memory_limit_bytes(), DEFAULT_MEMORY_LIMIT_BYTES);
+    ASSERT_FALSE(memory_limit_is_set());
+
+    ASSERT_TRUE(matches(execute({"--sample", "--memory_limit=lots"}, "M 0"), ".*exception=Expected a memory size.*"));
+}
+
+TEST(main_helper, prefer_tableau_sampling) {
+    Circuit small("H 0\nCNOT 0 1\nM 0 1");
+    ASSERT_TRUE(prefer_tableau_sampling(small, 1));
+    ASSERT_FALSE(prefer_tableau_sampling(small, 2));
+    ASSERT_FALSE(prefer_tableau_sampling(small, 1000));
+
+    Circuit big;
+    for (uint32_t k = 0; k < 2000; k += 2) {
+        big.append_op("H", {k});
+        big.append_op("CNOT", {k, k + 1});
+        big.append_op("X_ERROR", {k}, 0.01);
+    }
+    for (uint32_t k = 0; k < 2000; k++) {
+        big.append_op("M", {k});
+    }
+    ASSERT_TRUE(prefer_tableau_sampling(big, 1));
+    ASSERT_FALSE(prefer_tableau_sampling(big, 3));
+}
+
+TEST(main_helper, sample_measurements_out) {
+    auto &rng = SHARED_TEST_RNG();
+    Circuit circuit("X 0\nM 0 1 2\nREPEAT 2 {\n    M 0\n}");
+    for (bool frame0 : {false, true}) {
+        for (uint64_t num_shots : {0, 1, 3}) {
+            FILE *tmp = tmpfile();
+            sample_measurements_out(circuit, num_shots, frame0, tmp, SAMPLE_FORMAT_01, rng);
+            std::string expected;
+            for (uint64_t k = 0; k < num_shots; k++) {
+                expected += frame0 ? "00000\n" : "10011\n";
+            }
+            ASSERT_EQ(rewind_read_all(tmp), expected);
+        }
+    }
+}
+
 TEST(main_helper, intentional_failures) {
     ASSERT_EQ(
         "Sampled 10 which was not expected.",
@@ -695,6 +746,103 @@ TEST(main_helper, generate_circuits) {
         ".+Generated color_code.+"));
 }
 
+TEST(main_helper, generate_circuits_into_other_modes) {
+    ASSERT_EQ(
+        execute({"--gen=repetition_code", "--rounds=3", "--distance=3", "--task=memory", "--detect=2"}, nullptr),
+        "00000000\n00000000\n");
+    ASSERT_EQ(
+        execute({"--gen=repetition_code", "--rounds=3", "--distance=3", "--task=memory", "--sample=2"}, nullptr),
+        "000000000\n000000000\n");
+
+    std::vector<const char *> gen_flags{
+        "--gen=surface_code",
+        "--rounds=5",
+        "--distance=3",
+        "--task=rotated_memory_z",
+        "--after_clifford_depolarization=0.001",
+    };
+    auto text = execute(gen_flags, nullptr);
+    gen_flags.push_back("--analyze_errors");
+    ASSERT_EQ(execute(gen_flags, nullptr), execute({"--analyze_errors"}, text.data()));
+
+    ASSERT_EQ(
+        execute({"--gen=repetition_code", "--rounds=3", "--distance=3", "--task=memory", "--detect"}, "H 0"),
+        "[exception=Can't specify both `--gen` and `--in`.]");
+    ASSERT_TRUE(matches(
+        execute({"--gen=repetition_code", "--rounds=3", "--distance=3", "--task=memory", "--repl"}, nullptr),
+        ".*Need to pick a mode.*"));
+}
+
+TEST(main_helper, generate_circuit_sweep) {
+    ASSERT_EQ(
+        execute(
+            {"--gen=repetition_code", "--rounds=2,3", "--distance=2,3", "--task=memory", "--detect=2", "--threads=3"},
+            nullptr),
+        "# sweep: task=memory distance=2 rounds=2 after_clifford_depolarization=0 after_reset_flip_probability=0 "
+        "before_measure_flip_probability=0 before_round_data_depolarization=0\n"
+        "000\n000\n"
+        "# sweep: task=memory distance=2 rounds=3 after_clifford_depolarization=0 after_reset_flip_probability=0 "
+        "before_measure_flip_probability=0 before_round_data_depolarization=0\n"
+        "0000\n0000\n"
+        "# sweep: task=memory distance=3 rounds=2 after_clifford_depolarization=0 after_reset_flip_probability=0 "
+        "before_measure_flip_probability=0 before_round_data_depolarization=0\n"
+        "000000\n000000\n"
+        "# sweep: task=memory distance=3 rounds=3 after_clifford_depolarization=0 after_reset_flip_probability=0 "
+        "before_measure_flip_probability=0 before_round_data_depolarization=0\n"
+        "00000000\n00000000\n");
+
+    std::vector<const char *> single_point_flags{
+        "--gen=surface_code",
+        "--rounds=3",
+        "--distance=3",
+        "--task=rotated_memory_z",
+        "--before_measure_flip_probability=0.01",
+        "--analyze_errors",
+    };
+    auto single_point = execute(single_point_flags, nullptr);
+    auto sweep = execute(
+        {
+            "--gen=surface_code",
+            "--rounds=3",
+            "--distance=3",
+            "--task=rotated_memory_z",
+            "--before_measure_flip_probability=0.01,0.02",
+            "--analyze_errors",
+        },
+        nullptr);
+    ASSERT_EQ(sweep.find("# sweep: "), 0);
+    ASSERT_NE(sweep.find(single_point), std::string::npos);
+    ASSERT_NE(sweep.find("before_measure_flip_probability=0.02"), std::string::npos);
+
+    auto noise_sweep = execute(
+        {
+            "--gen=repetition_code",
+            "--rounds=2",
+            "--distance=3",
+            "--task=memory",
+            "--before_measure_flip_probability=0,0.2",
+            "--detect=2",
+        },
+        nullptr);
+    auto noiseless_header =
+        "# sweep: task=memory distance=3 rounds=2 after_clifford_depolarization=0 after_reset_flip_probability=0 "
+        "before_measure_flip_probability=0 before_round_data_depolarization=0\n"
+        "000000\n000000\n"
+        "# sweep: task=memory distance=3 rounds=2 after_clifford_depolarization=0 after_reset_flip_probability=0 "
+        "before_measure_flip_probability=0.2 before_round_data_depolarization=0\n";
+    ASSERT_EQ(noise_sweep.substr(0, strlen(noiseless_header)), noiseless_header);
+    ASSERT_TRUE(matches(noise_sweep.substr(strlen(noiseless_header)), "[01]{6}\n[01]{6}\n"));
+
+    ASSERT_EQ(
+        execute(
+            {"--gen=repetition_code", "--rounds=2,3", "--distance=3", "--task=memory", "--detect", "--out_format=b8"},
+            nullptr),
+        "[exception=Sweeps interleave results with comment lines, so need a text --out_format.]");
+    ASSERT_EQ(
+        execute({"--gen=repetition_code", "--rounds=2,3", "--distance=3", "--task=memory", "--sample"}, nullptr),
+        "[exception=Sweeping over generated circuits is only supported by --detect and --analyze_errors.]");
+}
+
 TEST(main_helper, detection_event_simulator_counts_measurements_correctly) {
     auto s = execute({"--detect=1000"}, "MPP Z8*X9\nDETECTOR rec[-1]");
     size_t zeroes = 0;
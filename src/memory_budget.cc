@@ -0,0 +1,144 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "memory_budget.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace stim_internal;
+
+static uint64_t memory_limit = DEFAULT_MEMORY_LIMIT_BYTES;
+static bool memory_limit_was_set = false;
+
+uint64_t stim_internal::memory_limit_bytes() {
+    return memory_limit;
+}
+
+void stim_internal::set_memory_limit_bytes(uint64_t limit) {
+    memory_limit = limit == 0 ? DEFAULT_MEMORY_LIMIT_BYTES : limit;
+    memory_limit_was_set = limit != 0;
+}
+
+bool stim_internal::memory_limit_is_set() {
+    return memory_limit_was_set;
+}
+
+size_t stim_internal::memory_limited_shot_batch_size(uint64_t bits_per_shot) {
+    if (!memory_limit_was_set) {
+        return MAX_SHOT_BATCH_SIZE;
+    }
+    uint64_t limit_bits = memory_limit > UINT64_MAX >> 3 ? UINT64_MAX : memory_limit << 3;
+    uint64_t shots = limit_bits / std::max(bits_per_shot, uint64_t{1});
+    if (shots >= MAX_SHOT_BATCH_SIZE) {
+        return MAX_SHOT_BATCH_SIZE;
+    }
+    return (size_t)std::max(shots & ~uint64_t{63}, uint64_t{64});
+}
+
+size_t stim_internal::memory_limited_file_buffer_size(size_t num_files) {
+    uint64_t size = (memory_limit >> 2) / std::max(num_files, size_t{1});
+    return (size_t)std::min(size, uint64_t{1} << 20);
+}
+
+uint64_t stim_internal::peak_memory_usage_bytes() {
+#if defined(__linux__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return (uint64_t)usage.ru_maxrss;
+#else
+    return (uint64_t)usage.ru_maxrss << 10;
+#endif
+#else
+    return 0;
+#endif
+}
+
+uint64_t stim_internal::parse_memory_size(const std::string &text) {
+    size_t k = 0;
+    uint64_t value = 0;
+    while (k < text.size() && text[k] >= '0' && text[k] <= '9') {
+        uint64_t next = value * 10 + (uint64_t)(text[k] - '0');
+        if (next / 10 != value) {
+            throw std::invalid_argument("Memory size is too large: '" + text + "'.");
+        }
+        value = next;
+        k++;
+    }
+    if (k == 0) {
+        throw std::invalid_argument("Expected a memory size like '512M' or '4G' but got '" + text + "'.");
+    }
+
+    size_t shift = 0;
+    if (k < text.size()) {
+        switch (text[k]) {
+            case 'K':
+            case 'k':
+                shift = 10;
+                break;
+            case 'M':
+            case 'm':
+                shift = 20;
+                break;
+            case 'G':
+            case 'g':
+                shift = 30;
+                break;
+            case 'T':
+            case 't':
+                shift = 40;
+                break;
+            default:
+                throw std::invalid_argument("Expected a memory size like '512M' or '4G' but got '" + text + "'.");
+        }
+        k++;
+        if (k < text.size() && (text[k] == 'B' || text[k] == 'b')) {
+            k++;
+        }
+    }
+    if (k != text.size()) {
+        throw std::invalid_argument("Expected a memory size like '512M' or '4G' but got '" + text + "'.");
+    }
+    if (shift && value > UINT64_MAX >> shift) {
+        throw std::invalid_argument("Memory size is too large: '" + text + "'.");
+    }
+    return value << shift;
+}
+
+std::string stim_internal::describe_memory_size(uint64_t bytes) {
+    const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    size_t unit = 0;
+    double value = (double)bytes;
+    while (value >= 1024 && unit + 1 < sizeof(units) / sizeof(units[0])) {
+        value /= 1024;
+        unit++;
+    }
+    std::stringstream ss;
+    if (unit == 0) {
+        ss << bytes << " B";
+    } else {
+        ss << std::fixed << std::setprecision(1) << value << " " << units[unit];
+    }
+    return ss.str();
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STIM_MEMORY_BUDGET_H
+#define STIM_MEMORY_BUDGET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace stim_internal {
+
+/// The default memory budget. Sampling streams results through temporary files once there are more than 10^8 of them.
+constexpr uint64_t DEFAULT_MEMORY_LIMIT_BYTES = uint64_t{100000000} >> 3;
+
+/// The widest batch of shots simulated at once. Each shot of a streamed batch is written through its own temporary
+/// file, so this stays well below typical file handle limits.
+constexpr size_t MAX_SHOT_BATCH_SIZE = 768;
+
+/// Returns the number of bytes that sampling tries to stay within.
+///
+/// The budget decides whether sampled results are held in memory or streamed through temporary files, how many shots
+/// are simulated at once, and how large the buffers of the temporary files are. It's a target, not a hard limit: the
+/// circuit itself and the state of a single batch of shots are always held in memory.
+uint64_t memory_limit_bytes();
+
+/// Sets the budget returned by `memory_limit_bytes`. A limit of 0 restores the default.
+void set_memory_limit_bytes(uint64_t limit);
+
+/// Returns true if a limit was explicitly set, instead of the default being in effect.
+///
+/// The default budget only reproduces the historical threshold for holding results in memory. Batch sizes and file
+/// buffers are only adjusted to fit the budget when a limit was explicitly set.
+bool memory_limit_is_set();
+
+/// Returns how many shots to simulate at once, so that a batch fits within the memory budget.
+///
+/// Batches only shrink when a limit has been explicitly set. The default budget is sized for holding results, not
+/// simulator state, so without a limit every batch keeps the full MAX_SHOT_BATCH_SIZE shots.
+///
+/// Args:
+///     bits_per_shot: The number of bits of simulator state and buffered results needed for each shot.
+///
+/// Returns:
+///     MAX_SHOT_BATCH_SIZE if no limit was set or if that many shots fit within the budget. Otherwise the largest
+///     multiple of 64 shots that fits, but at least 64.
+size_t memory_limited_shot_batch_size(uint64_t bits_per_shot);
+
+/// Returns the buffer size to use for each of several temporary files that are being written at the same time.
+///
+/// The buffers share a quarter of the memory budget, and are never larger than 1 MiB. Returns 0, meaning the files
+/// should be unbuffered, when the budget is too small to give each file a buffer.
+size_t memory_limited_file_buffer_size(size_t num_files);
+
+/// Returns the peak resident memory used by the process so far, in bytes, or 0 if the platform doesn't report it.
+uint64_t peak_memory_usage_bytes();
+
+/// Parses a number of bytes, with an optional binary unit suffix (K, M, G, or T, e.g. "512M" or "4G").
+uint64_t parse_memory_size(const std::string &text);
+
+/// Describes a number of bytes using binary units (e.g. "1.5 GiB").
+std::string describe_memory_size(uint64_t bytes);
+
+}  // namespace stim_internal
+
+#endif
@@ -0,0 +1,139 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "memory_budget.h"
+
+#include <gtest/gtest.h>
+
+#include "simulators/detection_simulator.h"
+#include "simulators/frame_simulator.h"
+#include "test_util.test.h"
+
+using namespace stim_internal;
+
+TEST(memory_budget, set_memory_limit_bytes) {
+    ASSERT_EQ(memory_limit_bytes(), DEFAULT_MEMORY_LIMIT_BYTES);
+    ASSERT_FALSE(memory_limit_is_set());
+    ASSERT_TRUE(should_use_streaming_instead_of_memory(100000001));
+    ASSERT_FALSE(should_use_streaming_instead_of_memory(100000000));
+    set_memory_limit_bytes(1 << 20);
+    ASSERT_EQ(memory_limit_bytes(), 1 << 20);
+    ASSERT_TRUE(memory_limit_is_set());
+    ASSERT_TRUE(should_use_streaming_instead_of_memory((8 << 20) + 8));
+    ASSERT_FALSE(should_use_streaming_instead_of_memory(8 << 20));
+    set_memory_limit_bytes(0);
+    ASSERT_EQ(memory_limit_bytes(), DEFAULT_MEMORY_LIMIT_BYTES);
+    ASSERT_FALSE(memory_limit_is_set());
+    ASSERT_TRUE(should_use_streaming_instead_of_memory(100000001));
+    ASSERT_FALSE(should_use_streaming_instead_of_memory(100000000));
+}
+
+TEST(memory_budget, memory_limited_shot_batch_size) {
+    ASSERT_EQ(memory_limited_shot_batch_size(1000), MAX_SHOT_BATCH_SIZE);
+    ASSERT_EQ(memory_limited_shot_batch_size(0), MAX_SHOT_BATCH_SIZE);
+
+    set_memory_limit_bytes(1 << 20);
+    ASSERT_EQ(memory_limited_shot_batch_size(1 << 13), 768);
+    ASSERT_EQ(memory_limited_shot_batch_size(1 << 14), 512);
+    ASSERT_EQ(memory_limited_shot_batch_size(3 << 13), 320);
+    ASSERT_EQ(memory_limited_shot_batch_size(1 << 30), 64);
+    set_memory_limit_bytes(UINT64_MAX);
+    ASSERT_EQ(memory_limited_shot_batch_size(UINT64_MAX), 64);
+    ASSERT_EQ(memory_limited_shot_batch_size(1 << 30), 768);
+    set_memory_limit_bytes(0);
+}
+
+TEST(memory_budget, default_shot_batch_size_ignores_circuit_size) {
+    auto circuit = Circuit(R"CIRCUIT(
+        H 199999
+        REPEAT 1000 {
+            M 199999
+        }
+        DETECTOR rec[-1000]
+    )CIRCUIT");
+    uint64_t bits_per_shot = 2 * (uint64_t)circuit.count_qubits() + 2 * (uint64_t)circuit.max_lookback();
+    ASSERT_GT(bits_per_shot * MAX_SHOT_BATCH_SIZE, DEFAULT_MEMORY_LIMIT_BYTES << 3);
+    ASSERT_EQ(memory_limited_shot_batch_size(bits_per_shot), MAX_SHOT_BATCH_SIZE);
+    set_memory_limit_bytes(DEFAULT_MEMORY_LIMIT_BYTES);
+    ASSERT_LT(memory_limited_shot_batch_size(bits_per_shot), MAX_SHOT_BATCH_SIZE);
+    set_memory_limit_bytes(0);
+    ASSERT_EQ(memory_limited_shot_batch_size(bits_per_shot), MAX_SHOT_BATCH_SIZE);
+}
+
+TEST(memory_budget, memory_limited_file_buffer_size) {
+    set_memory_limit_bytes(1);
+    ASSERT_EQ(memory_limited_file_buffer_size(10), 0);
+    set_memory_limit_bytes(1 << 20);
+    ASSERT_EQ(memory_limited_file_buffer_size(767), 341);
+    set_memory_limit_bytes(uint64_t{1} << 40);
+    ASSERT_EQ(memory_limited_file_buffer_size(10), 1 << 20);
+    set_memory_limit_bytes(uint64_t{1} << 28);
+    ASSERT_EQ(memory_limited_file_buffer_size(256), 1 << 18);
+    ASSERT_EQ(memory_limited_file_buffer_size(0), 1 << 20);
+    set_memory_limit_bytes(0);
+}
+
+TEST(memory_budget, parse_memory_size) {
+    ASSERT_EQ(parse_memory_size("0"), 0);
+    ASSERT_EQ(parse_memory_size("123"), 123);
+    ASSERT_EQ(parse_memory_size("2K"), 2048);
+    ASSERT_EQ(parse_memory_size("2kb"), 2048);
+    ASSERT_EQ(parse_memory_size("512M"), uint64_t{512} << 20);
+    ASSERT_EQ(parse_memory_size("4G"), uint64_t{4} << 30);
+    ASSERT_EQ(parse_memory_size("4GB"), uint64_t{4} << 30);
+    ASSERT_EQ(parse_memory_size("1T"), uint64_t{1} << 40);
+    ASSERT_EQ(parse_memory_size("18446744073709551615"), UINT64_MAX);
+    ASSERT_THROW({ parse_memory_size(""); }, std::invalid_argument);
+    ASSERT_THROW({ parse_memory_size("G"); }, std::invalid_argument);
+    ASSERT_THROW({ parse_memory_size("4X"); }, std::invalid_argument);
+    ASSERT_THROW({ parse_memory_size("4GBB"); }, std::invalid_argument);
+    ASSERT_THROW({ parse_memory_size("-4G"); }, std::invalid_argument);
+    ASSERT_THROW({ parse_memory_size("18446744073709551616"); }, std::invalid_argument);
+    ASSERT_THROW({ parse_memory_size("100000000T"); }, std::invalid_argument);
+}
+
+TEST(memory_budget, describe_memory_size) {
+    ASSERT_EQ(describe_memory_size(0), "0 B");
+    ASSERT_EQ(describe_memory_size(1023), "1023 B");
+    ASSERT_EQ(describe_memory_size(1536), "1.5 KiB");
+    ASSERT_EQ(describe_memory_size(uint64_t{3} << 30), "3.0 GiB");
+    ASSERT_EQ(describe_memory_size(uint64_t{5} << 50), "5120.0 TiB");
+}
+
+TEST(memory_budget, peak_memory_usage_bytes) {
+#if defined(__linux__) || defined(__APPLE__)
+    ASSERT_GT(peak_memory_usage_bytes(), 0);
+#endif
+}
+
+TEST(memory_budget, small_limit_gives_same_detection_samples) {
+    auto circuit = Circuit(R"CIRCUIT(
+        REPEAT 100 {
+            X_ERROR(1) 0
+            M 0 1
+            DETECTOR rec[-2]
+            DETECTOR rec[-1]
+        }
+        OBSERVABLE_INCLUDE(0) rec[-2]
+    )CIRCUIT");
+    FILE *tmp = tmpfile();
+    detector_samples_out(circuit, 1000, true, false, tmp, SAMPLE_FORMAT_01, SHARED_TEST_RNG());
+    auto expected = rewind_read_all(tmp);
+
+    set_memory_limit_bytes(1);
+    tmp = tmpfile();
+    detector_samples_out(circuit, 1000, true, false, tmp, SAMPLE_FORMAT_01, SHARED_TEST_RNG());
+    set_memory_limit_bytes(0);
+    ASSERT_EQ(rewind_read_all(tmp), expected);
+}
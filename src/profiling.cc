@@ -0,0 +1,78 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "profiling.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "circuit/gate_data.h"
+
+using namespace stim_internal;
+
+Profiler stim_internal::GLOBAL_PROFILER{};
+
+static const char *PROFILE_SECTION_NAMES[NUM_PROFILE_SECTIONS] = {
+    "frame_simulator",
+    "tableau_simulator",
+    "error_analyzer",
+};
+
+void Profiler::clear() {
+    memset(gates, 0, sizeof(gates));
+    transposes = {};
+    writers = {};
+}
+
+std::vector<ProfileEntry> Profiler::entries() const {
+    std::vector<ProfileEntry> result;
+    for (const auto &gate : GATE_DATA.gates()) {
+        const Gate &canon = GATE_DATA.at(gate.name);
+        if (strcmp(canon.name, gate.name) != 0) {
+            // Skip aliases.
+            continue;
+        }
+        for (size_t s = 0; s < NUM_PROFILE_SECTIONS; s++) {
+            const ProfileStats &stats = gates[s][canon.id];
+            if (stats.count) {
+                result.push_back({PROFILE_SECTION_NAMES[s], canon.name, stats});
+            }
+        }
+    }
+    if (transposes.count) {
+        result.push_back({"transpose", "", transposes});
+    }
+    if (writers.count) {
+        result.push_back({"writer", "", writers});
+    }
+    std::stable_sort(result.begin(), result.end(), [](const ProfileEntry &a, const ProfileEntry &b) {
+        return a.stats.nanos > b.stats.nanos;
+    });
+    return result;
+}
+
+std::string Profiler::str() const {
+    std::stringstream out;
+    out << std::left << std::setw(20) << "section" << std::setw(24) << "name" << std::right << std::setw(12)
+        << "count" << std::setw(14) << "seconds" << std::setw(16) << "bytes touched"
+        << "\n";
+    for (const auto &e : entries()) {
+        out << std::left << std::setw(20) << e.section << std::setw(24) << e.name << std::right << std::setw(12)
+            << e.stats.count << std::setw(14) << std::fixed << std::setprecision(6) << (e.stats.nanos * 1e-9)
+            << std::setw(16) << e.stats.bytes << "\n";
+    }
+    return out.str();
+}
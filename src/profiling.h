@@ -0,0 +1,124 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STIM_PROFILING_H
+#define STIM_PROFILING_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace stim_internal {
+
+/// Accumulated statistics about one kind of profiled work.
+struct ProfileStats {
+    /// Number of times the work was done.
+    uint64_t count;
+    /// Total wall clock time spent doing the work.
+    uint64_t nanos;
+    /// Estimated number of bytes of simulator state read or written while doing the work.
+    uint64_t bytes;
+};
+
+/// The simulators whose gate dispatch is profiled.
+enum ProfileSection : uint8_t {
+    PROFILE_FRAME_SIMULATOR,
+    PROFILE_TABLEAU_SIMULATOR,
+    PROFILE_ERROR_ANALYZER,
+    NUM_PROFILE_SECTIONS,
+};
+
+/// One line of a profile report.
+struct ProfileEntry {
+    /// Where the work happened (e.g. "frame_simulator" or "transpose").
+    std::string section;
+    /// What the work was (e.g. a gate name), or empty if the section isn't subdivided.
+    std::string name;
+    ProfileStats stats;
+};
+
+/// Opt-in instrumentation reporting where time goes while sampling or analyzing circuits.
+///
+/// The instrumentation is always compiled in, but is disabled by default. When disabled, each instrumented location
+/// costs one well predicted branch.
+///
+/// Not thread safe. Time is inclusive: e.g. the time spent by a measurement gate in the tableau simulator includes
+/// the time spent transposing the tableau, and the time spent writing results includes transposing the results.
+struct Profiler {
+    bool enabled;
+    ProfileStats gates[NUM_PROFILE_SECTIONS][256];
+    ProfileStats transposes;
+    ProfileStats writers;
+
+    /// Zeroes all accumulated statistics.
+    void clear();
+    /// Returns the non-empty statistics, with gates identified by name, sorted from most to least time.
+    std::vector<ProfileEntry> entries() const;
+    /// Returns a human readable table describing the accumulated statistics.
+    std::string str() const;
+};
+
+extern Profiler GLOBAL_PROFILER;
+
+/// Attributes the cost of the enclosing scope to the given statistics, if profiling is enabled.
+struct ProfileScope {
+    /// Where to accumulate the cost, or nullptr if profiling was disabled when the scope was entered.
+    ProfileStats *stats;
+    std::chrono::steady_clock::time_point start;
+
+    inline explicit ProfileScope(ProfileStats &target) : stats(GLOBAL_PROFILER.enabled ? &target : nullptr) {
+        if (stats != nullptr) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+    inline ~ProfileScope() {
+        if (stats != nullptr) {
+            auto end = std::chrono::steady_clock::now();
+            stats->count++;
+            stats->nanos += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+    }
+    /// Adds to the number of bytes touched. The estimate should be cheap, since it's computed even when disabled.
+    inline void add_bytes(uint64_t bytes) {
+        if (stats != nullptr) {
+            stats->bytes += bytes;
+        }
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+/// Runs the given body, attributing its cost to the given statistics if profiling is enabled.
+///
+/// Args:
+///     stats: Where to accumulate the cost of the body.
+///     estimate_bytes: Returns an estimate of the number of bytes the body touches. Only called when profiling.
+///     body: The work to do.
+template <typename BYTES, typename BODY>
+inline void profiled(ProfileStats &stats, const BYTES &estimate_bytes, const BODY &body) {
+    if (!GLOBAL_PROFILER.enabled) {
+        body();
+        return;
+    }
+    ProfileScope scope(stats);
+    scope.add_bytes(estimate_bytes());
+    body();
+}
+
+}  // namespace stim_internal
+
+#endif
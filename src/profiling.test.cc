@@ -0,0 +1,79 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "profiling.h"
+
+#include <gtest/gtest.h>
+
+#include "circuit/circuit.h"
+#include "simulators/error_analyzer.h"
+#include "simulators/frame_simulator.h"
+#include "simulators/tableau_simulator.h"
+#include "test_util.test.h"
+
+using namespace stim_internal;
+
+static const ProfileEntry *find_entry(const std::vector<ProfileEntry> &entries, const char *section, const char *name) {
+    for (const auto &e : entries) {
+        if (e.section == section && e.name == name) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+TEST(profiling, disabled_by_default) {
+    ASSERT_FALSE(GLOBAL_PROFILER.enabled);
+    GLOBAL_PROFILER.clear();
+    auto circuit = Circuit(R"CIRCUIT(
+        H 0
+        CNOT 0 1
+        M 0 1
+    )CIRCUIT");
+    TableauSimulator::sample_circuit(circuit, SHARED_TEST_RNG());
+    ASSERT_TRUE(GLOBAL_PROFILER.entries().empty());
+}
+
+TEST(profiling, counts_gates_per_simulator) {
+    auto circuit = Circuit(R"CIRCUIT(
+        H 0
+        CNOT 0 1 2 3
+        X_ERROR(0.1) 0 1 2
+        M 0 1
+        DETECTOR rec[-1] rec[-2]
+    )CIRCUIT");
+
+    GLOBAL_PROFILER.clear();
+    GLOBAL_PROFILER.enabled = true;
+    auto ref = TableauSimulator::reference_sample_circuit(circuit);
+    FrameSimulator::sample(circuit, ref, 100, SHARED_TEST_RNG());
+    ErrorAnalyzer::circuit_to_detector_error_model(circuit, false, false, false, 0);
+    GLOBAL_PROFILER.enabled = false;
+
+    auto entries = GLOBAL_PROFILER.entries();
+    ASSERT_EQ(find_entry(entries, "tableau_simulator", "CX")->stats.count, 1);
+    ASSERT_EQ(find_entry(entries, "frame_simulator", "CX")->stats.count, 1);
+    ASSERT_EQ(find_entry(entries, "frame_simulator", "X_ERROR")->stats.count, 1);
+    ASSERT_EQ(find_entry(entries, "error_analyzer", "X_ERROR")->stats.count, 1);
+    ASSERT_GT(find_entry(entries, "frame_simulator", "CX")->stats.bytes, 0);
+    ASSERT_EQ(find_entry(entries, "frame_simulator", "CNOT"), nullptr);
+    ASSERT_NE(find_entry(entries, "transpose", ""), nullptr);
+    for (size_t k = 1; k < entries.size(); k++) {
+        ASSERT_GE(entries[k - 1].stats.nanos, entries[k].stats.nanos);
+    }
+    ASSERT_NE(GLOBAL_PROFILER.str().find("frame_simulator"), std::string::npos);
+
+    GLOBAL_PROFILER.clear();
+    ASSERT_TRUE(GLOBAL_PROFILER.entries().empty());
+}
@@ -33,4 +33,12 @@ bool normalize_index_or_slice(
     pybind11::ssize_t *step,
     pybind11::ssize_t *slice_length);
 
+/// Copies the contents of a vector into a new one dimensional numpy array.
+template <typename T>
+pybind11::array_t<T> vec_to_numpy(const std::vector<T> &values) {
+    pybind11::array_t<T> result((pybind11::ssize_t)values.size());
+    std::copy(values.begin(), values.end(), result.mutable_data());
+    return result;
+}
+
 #endif
@@ -22,13 +22,13 @@
 
 using namespace stim_internal;
 
-CompiledDetectorSampler::CompiledDetectorSampler(Circuit circuit) : dets_obs(circuit), circuit(std::move(circuit)) {
+CompiledDetectorSampler::CompiledDetectorSampler(Circuit circuit) : program(circuit), circuit(std::move(circuit)) {
 }
 
 pybind11::array_t<uint8_t> CompiledDetectorSampler::sample(
     size_t num_shots, bool prepend_observables, bool append_observables) {
     auto sample =
-        detector_samples(circuit, dets_obs, num_shots, prepend_observables, append_observables, PYBIND_SHARED_RNG())
+        detector_samples(circuit, program, num_shots, prepend_observables, append_observables, PYBIND_SHARED_RNG())
             .transposed();
 
     const simd_bits &flat = sample.data;
@@ -42,7 +42,7 @@ pybind11::array_t<uint8_t> CompiledDetectorSampler::sample(
         }
     }
 
-    size_t n = dets_obs.detectors.size() + dets_obs.observables.size() * (prepend_observables + append_observables);
+    size_t n = program.num_detectors + program.num_observables * (prepend_observables + append_observables);
 
     void *ptr = bytes.data();
     ssize_t itemsize = sizeof(uint8_t);
@@ -56,9 +56,9 @@ pybind11::array_t<uint8_t> CompiledDetectorSampler::sample(
 pybind11::array_t<uint8_t> CompiledDetectorSampler::sample_bit_packed(
     size_t num_shots, bool prepend_observables, bool append_observables) {
     auto sample =
-        detector_samples(circuit, dets_obs, num_shots, prepend_observables, append_observables, PYBIND_SHARED_RNG())
+        detector_samples(circuit, program, num_shots, prepend_observables, append_observables, PYBIND_SHARED_RNG())
             .transposed();
-    size_t n = dets_obs.detectors.size() + dets_obs.observables.size() * (prepend_observables + append_observables);
+    size_t n = program.num_detectors + program.num_observables * (prepend_observables + append_observables);
 
     void *ptr = sample.data.u8;
     ssize_t itemsize = sizeof(uint8_t);
@@ -77,7 +77,8 @@ void CompiledDetectorSampler::sample_write(
     bool append_observables) {
     auto f = format_to_enum(format);
     FILE *out = fopen(filepath.data(), "w");
-    detector_samples_out(circuit, num_samples, prepend_observables, append_observables, out, f, PYBIND_SHARED_RNG());
+    detector_samples_out(
+        circuit, program, num_samples, prepend_observables, append_observables, out, f, PYBIND_SHARED_RNG());
     fclose(out);
 }
 
@@ -21,11 +21,12 @@
 
 #include "../circuit/circuit.h"
 #include "../simd/simd_bits.h"
+#include "../simulators/detector_xor_program.h"
 
 void pybind_compiled_detector_sampler(pybind11::module &m);
 
 struct CompiledDetectorSampler {
-    const stim_internal::DetectorsAndObservables dets_obs;
+    const stim_internal::DetectorXorProgram program;
     const stim_internal::Circuit circuit;
     CompiledDetectorSampler(stim_internal::Circuit circuit);
     pybind11::array_t<uint8_t> sample(size_t num_shots, bool prepend_observables, bool append_observables);
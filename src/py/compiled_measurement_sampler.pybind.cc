@@ -61,6 +61,10 @@ pybind11::array_t<uint8_t> CompiledMeasurementSampler::sample_bit_packed(size_t
     return pybind11::array_t<uint8_t>(pybind11::buffer_info(ptr, itemsize, format, 2, shape, stride, readonly));
 }
 
+void CompiledMeasurementSampler::set_noise_args(size_t instruction_index, const std::vector<double> &args) {
+    circuit.set_noise_args(instruction_index, args);
+}
+
 void CompiledMeasurementSampler::sample_write(
     size_t num_samples, const std::string &filepath, const std::string &format) {
     auto f = format_to_enum(format);
@@ -174,6 +178,40 @@ void pybind_compiled_measurement_sampler(pybind11::module &m) {
         )DOC")
             .data());
 
+    c.def(
+        "set_noise_args",
+        &CompiledMeasurementSampler::set_noise_args,
+        pybind11::arg("instruction_index"),
+        pybind11::arg("args"),
+        clean_doc_string(u8R"DOC(
+            Overwrites the probabilities of one of the circuit's noisy instructions, without recompiling the sampler.
+
+            Compiling a sampler computes a noiseless reference sample of the circuit, which can be expensive. Noise
+            probabilities (the arguments of noise channels, and the result flip probabilities of measurements) don't
+            affect the reference sample, so they can be changed without redoing that work. This is useful for
+            sweeping over noise strengths.
+
+            Examples:
+                >>> import stim
+                >>> s = stim.Circuit('''
+                ...    X_ERROR(0) 0
+                ...    M 0
+                ... ''').compile_sampler()
+                >>> s.sample(shots=1)
+                array([[0]], dtype=uint8)
+                >>> s.set_noise_args(0, [1])
+                >>> s.sample(shots=1)
+                array([[1]], dtype=uint8)
+
+            Args:
+                instruction_index: The index of a top-level noise channel or noisy measurement in the circuit.
+                args: The new parens arguments of the instruction. Must be as many as the instruction already has.
+
+            Raises:
+                ValueError: The instruction isn't noisy, or the arguments are invalid.
+        )DOC")
+            .data());
+
     c.def(
         "__repr__",
         &CompiledMeasurementSampler::repr,
@@ -26,8 +26,9 @@ void pybind_compiled_measurement_sampler(pybind11::module &m);
 
 struct CompiledMeasurementSampler {
     const stim_internal::simd_bits ref;
-    const stim_internal::Circuit circuit;
+    stim_internal::Circuit circuit;
     CompiledMeasurementSampler(stim_internal::Circuit circuit);
+    void set_noise_args(size_t instruction_index, const std::vector<double> &args);
     pybind11::array_t<uint8_t> sample(size_t num_samples);
     pybind11::array_t<uint8_t> sample_bit_packed(size_t num_samples);
     void sample_write(size_t num_samples, const std::string &filepath, const std::string &format);
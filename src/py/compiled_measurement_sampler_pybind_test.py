@@ -14,6 +14,7 @@
 import tempfile
 
 import numpy as np
+import pytest
 import stim
 
 
@@ -85,3 +86,30 @@ def test_sample_write():
         c.compile_sampler().sample_write(5, filepath=path, format='01')
         with open(path, 'r') as f:
             assert f.readlines() == ['1000110\n'] * 5
+
+
+def test_compiled_measurement_sampler_set_noise_args():
+    c = stim.Circuit("""
+        X 1
+        X_ERROR(0) 0
+        M 0 1
+        M(0) 2
+    """)
+    s = c.compile_sampler()
+    np.testing.assert_array_equal(s.sample(3), [[0, 1, 0]] * 3)
+
+    s.set_noise_args(1, [1])
+    np.testing.assert_array_equal(s.sample(3), [[1, 1, 0]] * 3)
+    s.set_noise_args(3, [1])
+    np.testing.assert_array_equal(s.sample(3), [[1, 1, 1]] * 3)
+    s.set_noise_args(1, [0])
+    np.testing.assert_array_equal(s.sample(3), [[0, 1, 1]] * 3)
+
+    with pytest.raises(ValueError, match="noise"):
+        s.set_noise_args(0, [1])
+    with pytest.raises(ValueError):
+        s.set_noise_args(1, [2])
+    with pytest.raises(ValueError):
+        s.set_noise_args(1, [0.5, 0.5])
+    with pytest.raises(ValueError):
+        s.set_noise_args(4, [0.5])
@@ -18,8 +18,12 @@
 
 #include "../circuit/circuit.pybind.h"
 #include "../dem/detector_error_model.pybind.h"
+#include "../memory_budget.h"
+#include "../profiling.h"
 #include "../simulators/tableau_simulator.pybind.h"
+#include "../simulators/zx_graph_solver.pybind.h"
 #include "../stabilizers/pauli_string.pybind.h"
+#include "../stabilizers/pauli_string_batch.pybind.h"
 #include "../stabilizers/tableau.pybind.h"
 #include "base.pybind.h"
 #include "compiled_detector_sampler.pybind.h"
@@ -53,6 +57,24 @@ uint32_t target_z(uint32_t qubit, bool invert) {
     return GateTarget::z(qubit, invert).data;
 }
 
+void set_profiling_enabled(bool enabled) {
+    GLOBAL_PROFILER.enabled = enabled;
+}
+
+pybind11::list get_profile() {
+    pybind11::list result;
+    for (const auto &e : GLOBAL_PROFILER.entries()) {
+        pybind11::dict d;
+        d["section"] = e.section;
+        d["name"] = e.name;
+        d["count"] = e.stats.count;
+        d["seconds"] = e.stats.nanos * 1e-9;
+        d["bytes"] = e.stats.bytes;
+        result.append(d);
+    }
+    return result;
+}
+
 PYBIND11_MODULE(stim, m) {
     m.attr("__version__") = xstr(VERSION_INFO);
     m.doc() = R"pbdoc(
@@ -70,7 +92,109 @@ PYBIND11_MODULE(stim, m) {
     pybind_circuit(m);
     pybind_pauli_string(m);
     pybind_tableau(m);
+    pybind_pauli_string_batch(m);
     pybind_tableau_simulator(m);
+    pybind_zx_graph_solver(m);
+
+    m.def(
+        "set_profiling_enabled",
+        &set_profiling_enabled,
+        pybind11::arg("enabled"),
+        clean_doc_string(u8R"DOC(
+            Turns stim's internal profiling on or off.
+
+            While profiling is enabled, stim accumulates the number of times each gate is applied by each simulator,
+            the time spent applying it, and an estimate of the number of bytes of simulator state it touched. Time
+            spent transposing bit tables and writing results is also accumulated. Profiling is off by default, and
+            costs a small amount of time while on.
+
+            Args:
+                enabled: Whether or not to accumulate profiling data.
+
+            Examples:
+                >>> import stim
+                >>> stim.clear_profile()
+                >>> stim.set_profiling_enabled(True)
+                >>> _ = stim.Circuit('H 0 \n CNOT 0 1 \n M 0 1').compile_sampler().sample(10)
+                >>> stim.set_profiling_enabled(False)
+                >>> sorted((e['section'], e['count']) for e in stim.get_profile() if e['name'] == 'CX')
+                [('frame_simulator', 1), ('tableau_simulator', 1)]
+        )DOC")
+            .data());
+
+    m.def(
+        "get_profile",
+        &get_profile,
+        clean_doc_string(u8R"DOC(
+            Returns the profiling data accumulated while profiling was enabled.
+
+            See `stim.set_profiling_enabled`.
+
+            Returns:
+                A list of dictionaries, sorted from most time spent to least time spent. Each dictionary has the keys
+                'section' (e.g. 'frame_simulator', 'tableau_simulator', 'error_analyzer', 'transpose', or 'writer'),
+                'name' (the gate's canonical name, or '' for sections that aren't split by gate), 'count', 'seconds',
+                and 'bytes' (an estimate of the number of bytes of state touched). Times are inclusive, so e.g. the
+                time spent measuring in the tableau simulator includes time spent transposing the tableau.
+        )DOC")
+            .data());
+
+    m.def(
+        "clear_profile",
+        []() {
+            GLOBAL_PROFILER.clear();
+        },
+        clean_doc_string(u8R"DOC(
+            Discards all accumulated profiling data. Doesn't change whether or not profiling is enabled.
+        )DOC")
+            .data());
+
+    m.def(
+        "set_memory_limit",
+        [](uint64_t num_bytes) {
+            set_memory_limit_bytes(num_bytes);
+        },
+        pybind11::arg("num_bytes"),
+        clean_doc_string(u8R"DOC(
+            Sets the amount of memory that stim's samplers try to stay within.
+
+            The limit decides whether results written to files (e.g. by `stim.CompiledDetectorSampler.sample_write`)
+            are held in memory or streamed through temporary files, how many shots are simulated at once, and how
+            large the buffers of the temporary files are. The circuit itself isn't counted against the limit, and
+            methods that return sampled data as a numpy array always hold that data in memory.
+
+            Args:
+                num_bytes: The memory budget in bytes. Use 0 to restore the default budget (enough to hold 10^8
+                    results).
+
+            Examples:
+                >>> import stim
+                >>> stim.set_memory_limit(4 * 2**30)
+                >>> stim.get_memory_limit()
+                4294967296
+                >>> stim.set_memory_limit(0)
+        )DOC")
+            .data());
+
+    m.def(
+        "get_memory_limit",
+        &memory_limit_bytes,
+        clean_doc_string(u8R"DOC(
+            Returns the amount of memory, in bytes, that stim's samplers try to stay within.
+
+            See `stim.set_memory_limit`.
+        )DOC")
+            .data());
+
+    m.def(
+        "get_peak_memory_usage",
+        &peak_memory_usage_bytes,
+        clean_doc_string(u8R"DOC(
+            Returns the peak resident memory used by the process so far, in bytes.
+
+            Returns 0 on platforms that don't report peak memory usage.
+        )DOC")
+            .data());
 
     m.def(
         "target_rec",
@@ -27,3 +27,58 @@ def test_targets():
     assert stim.target_inv(5) & 0xFFFF == 5
     assert stim.target_rec(-5) & 0xFFFF == 5
     assert isinstance(stim.target_combiner(), stim.GateTarget)
+
+
+def test_memory_limit(tmp_path):
+    assert stim.get_memory_limit() > 0
+    default = stim.get_memory_limit()
+    circuit = stim.Circuit("""
+        X_ERROR(1) 0
+        M 0 1
+        DETECTOR rec[-2]
+        DETECTOR rec[-1]
+        OBSERVABLE_INCLUDE(0) rec[-2]
+    """)
+    path = str(tmp_path / 'out.01')
+    circuit.compile_detector_sampler().sample_write(1000, filepath=path, format='01', prepend_observables=True)
+    with open(path) as f:
+        expected = f.read()
+    assert expected == '110\n' * 1000
+
+    # A tiny budget forces results to be streamed through temporary files.
+    stim.set_memory_limit(1)
+    try:
+        assert stim.get_memory_limit() == 1
+        circuit.compile_detector_sampler().sample_write(1000, filepath=path, format='01', prepend_observables=True)
+    finally:
+        stim.set_memory_limit(0)
+    with open(path) as f:
+        assert f.read() == expected
+    assert stim.get_memory_limit() == default
+    assert stim.get_peak_memory_usage() >= 0
+
+
+def test_profiling():
+    stim.clear_profile()
+    assert stim.get_profile() == []
+    stim.set_profiling_enabled(True)
+    try:
+        stim.Circuit("""
+            H 0
+            CNOT 0 1
+            X_ERROR(0.1) 0 1
+            M 0 1
+            DETECTOR rec[-1] rec[-2]
+        """).compile_detector_sampler().sample(100)
+    finally:
+        stim.set_profiling_enabled(False)
+    profile = stim.get_profile()
+    entries = {(e['section'], e['name']): e for e in profile}
+    assert entries[('frame_simulator', 'CX')]['count'] == 1
+    assert entries[('frame_simulator', 'X_ERROR')]['count'] == 1
+    assert entries[('frame_simulator', 'CX')]['bytes'] > 0
+    assert all(e['seconds'] >= 0 for e in profile)
+    assert [e['seconds'] for e in profile] == sorted([e['seconds'] for e in profile], reverse=True)
+
+    stim.clear_profile()
+    assert stim.get_profile() == []
@@ -20,6 +20,7 @@
 #include <sstream>
 
 #include "simd_util.h"
+#include "../profiling.h"
 
 using namespace stim_internal;
 
@@ -159,6 +160,8 @@ simd_bit_table simd_bit_table::slice_maj(size_t maj_start_bit, size_t maj_stop_b
 }
 
 void simd_bit_table::transpose_into(simd_bit_table &out) const {
+    ProfileScope profile_scope(GLOBAL_PROFILER.transposes);
+    profile_scope.add_bytes(data.num_u8_padded() * 2);
     assert(out.num_simd_words_minor == num_simd_words_major);
     assert(out.num_simd_words_major == num_simd_words_minor);
 
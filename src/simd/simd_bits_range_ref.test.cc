@@ -22,10 +22,10 @@ using namespace stim_internal;
 
 TEST(simd_bits_range_ref, construct) {
     alignas(64) uint64_t data[16]{};
-    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / sizeof(simd_word));
+    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / (sizeof(simd_word)));
 
     ASSERT_EQ(ref.ptr_simd, (simd_word *)&data[0]);
-    ASSERT_EQ(ref.num_simd_words, 16 * sizeof(uint64_t) / sizeof(simd_word));
+    ASSERT_EQ(ref.num_simd_words, 16 * sizeof(uint64_t) / (sizeof(simd_word)));
     ASSERT_EQ(ref.num_bits_padded(), 1024);
     ASSERT_EQ(ref.num_u8_padded(), 128);
     ASSERT_EQ(ref.num_u16_padded(), 64);
@@ -36,8 +36,8 @@ TEST(simd_bits_range_ref, construct) {
 TEST(simd_bits_range_ref, aliased_editing_and_bit_refs) {
     alignas(64) uint64_t data[16]{};
     auto c = (char *)&data;
-    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / sizeof(simd_word));
-    const simd_bits_range_ref cref((simd_word *)data, sizeof(data) / sizeof(simd_word));
+    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / (sizeof(simd_word)));
+    const simd_bits_range_ref cref((simd_word *)data, sizeof(data) / (sizeof(simd_word)));
 
     ASSERT_EQ(c[0], 0);
     ASSERT_EQ(c[13], 0);
@@ -55,7 +55,7 @@ TEST(simd_bits_range_ref, aliased_editing_and_bit_refs) {
 
 TEST(simd_bits_range_ref, str) {
     alignas(64) uint64_t data[8]{};
-    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / sizeof(simd_word));
+    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / (sizeof(simd_word)));
     ASSERT_EQ(
         ref.str(),
         "________________________________________________________________"
@@ -81,7 +81,7 @@ TEST(simd_bits_range_ref, str) {
 
 TEST(simd_bits_range_ref, randomize) {
     alignas(64) uint64_t data[16]{};
-    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / sizeof(simd_word));
+    simd_bits_range_ref ref((simd_word *)data, sizeof(data) / (sizeof(simd_word)));
 
     ref.randomize(64 + 57, SHARED_TEST_RNG());
     uint64_t mask = (1ULL << 57) - 1;
@@ -112,9 +112,9 @@ TEST(simd_bits_range_ref, randomize) {
 
 TEST(simd_bits_range_ref, xor_assignment) {
     alignas(64) uint64_t data[24]{};
-    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / sizeof(simd_word) / 3);
-    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / sizeof(simd_word) / 3);
-    simd_bits_range_ref m2((simd_word *)&data[16], sizeof(data) / sizeof(simd_word) / 3);
+    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / (sizeof(simd_word)) / 3);
+    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / (sizeof(simd_word)) / 3);
+    simd_bits_range_ref m2((simd_word *)&data[16], sizeof(data) / (sizeof(simd_word)) / 3);
     m0.randomize(512, SHARED_TEST_RNG());
     m1.randomize(512, SHARED_TEST_RNG());
     ASSERT_NE(m0, m1);
@@ -129,8 +129,8 @@ TEST(simd_bits_range_ref, xor_assignment) {
 
 TEST(simd_bits_range_ref, assignment) {
     alignas(64) uint64_t data[16]{};
-    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / sizeof(simd_word) / 2);
-    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / sizeof(simd_word) / 2);
+    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / (sizeof(simd_word)) / 2);
+    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / (sizeof(simd_word)) / 2);
     m0.randomize(512, SHARED_TEST_RNG());
     m1.randomize(512, SHARED_TEST_RNG());
     auto old_m1 = m1.u64[0];
@@ -143,9 +143,9 @@ TEST(simd_bits_range_ref, assignment) {
 
 TEST(simd_bits_range_ref, equality) {
     alignas(64) uint64_t data[32]{};
-    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / sizeof(simd_word) / 4);
-    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / sizeof(simd_word) / 4);
-    simd_bits_range_ref m4((simd_word *)&data[16], sizeof(data) / sizeof(simd_word) / 2);
+    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / (sizeof(simd_word)) / 4);
+    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / (sizeof(simd_word)) / 4);
+    simd_bits_range_ref m4((simd_word *)&data[16], sizeof(data) / (sizeof(simd_word)) / 2);
 
     ASSERT_TRUE(m0 == m1);
     ASSERT_FALSE(m0 != m1);
@@ -162,10 +162,10 @@ TEST(simd_bits_range_ref, equality) {
 
 TEST(simd_bits_range_ref, swap_with) {
     alignas(64) uint64_t data[32]{};
-    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / sizeof(simd_word) / 4);
-    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / sizeof(simd_word) / 4);
-    simd_bits_range_ref m2((simd_word *)&data[16], sizeof(data) / sizeof(simd_word) / 4);
-    simd_bits_range_ref m3((simd_word *)&data[24], sizeof(data) / sizeof(simd_word) / 4);
+    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / (sizeof(simd_word)) / 4);
+    simd_bits_range_ref m1((simd_word *)&data[8], sizeof(data) / (sizeof(simd_word)) / 4);
+    simd_bits_range_ref m2((simd_word *)&data[16], sizeof(data) / (sizeof(simd_word)) / 4);
+    simd_bits_range_ref m3((simd_word *)&data[24], sizeof(data) / (sizeof(simd_word)) / 4);
     m0.randomize(512, SHARED_TEST_RNG());
     m1.randomize(512, SHARED_TEST_RNG());
     m2 = m0;
@@ -179,7 +179,7 @@ TEST(simd_bits_range_ref, swap_with) {
 
 TEST(simd_bits_range_ref, clear) {
     alignas(64) uint64_t data[8]{};
-    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / sizeof(simd_word));
+    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / (sizeof(simd_word)));
     m0.randomize(512, SHARED_TEST_RNG());
     ASSERT_TRUE(m0.not_zero());
     m0.clear();
@@ -188,7 +188,7 @@ TEST(simd_bits_range_ref, clear) {
 
 TEST(simd_bits_range_ref, not_zero256) {
     alignas(64) uint64_t data[8]{};
-    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / sizeof(simd_word));
+    simd_bits_range_ref m0((simd_word *)&data[0], sizeof(data) / (sizeof(simd_word)));
     ASSERT_FALSE(m0.not_zero());
     m0[5] = true;
     ASSERT_TRUE(m0.not_zero());
@@ -200,8 +200,8 @@ TEST(simd_bits_range_ref, not_zero256) {
 
 TEST(simd_bits_range_ref, word_range_ref) {
     simd_word d[sizeof(uint64_t) * 16 / sizeof(simd_word)]{};
-    simd_bits_range_ref ref(d, sizeof(d) / sizeof(simd_word));
-    const simd_bits_range_ref cref(d, sizeof(d) / sizeof(simd_word));
+    simd_bits_range_ref ref(d, sizeof(d) / (sizeof(simd_word)));
+    const simd_bits_range_ref cref(d, sizeof(d) / (sizeof(simd_word)));
     auto r1 = ref.word_range_ref(1, 2);
     auto r2 = ref.word_range_ref(2, 2);
     r1[1] = true;
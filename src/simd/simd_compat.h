@@ -21,6 +21,8 @@
 #include "simd_compat_avx2.h"
 #elif __SSE2__
 #include "simd_compat_sse2.h"
+#elif __wasm_simd128__
+#include "simd_compat_simd128.h"
 #else
 #include "simd_compat_polyfill.h"
 #endif
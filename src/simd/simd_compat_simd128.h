@@ -0,0 +1,127 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/// Implements `simd_word` using WebAssembly SIMD128 intrinsic instructions.
+/// For example, `wasm_v128_xor` is SIMD128. Enabled by compiling with `-msimd128` (e.g. using emscripten).
+
+#include <stdlib.h>
+#include <wasm_simd128.h>
+
+#include "simd_util.h"
+
+namespace stim_internal {
+
+#define simd_word simd_word_simd128
+struct simd_word_simd128 {
+    union {
+        v128_t val;
+        v128_t u128[1];
+        uint64_t u64[2];
+        uint8_t u8[16];
+    };
+
+    static void *aligned_malloc(size_t bytes) {
+        void *result = nullptr;
+        if (posix_memalign(&result, sizeof(simd_word), bytes)) {
+            return nullptr;
+        }
+        return result;
+    }
+    static void aligned_free(void *ptr) {
+        free(ptr);
+    }
+
+    inline simd_word() : val(wasm_i64x2_splat(0)) {
+    }
+    inline simd_word(v128_t val) : val(val) {
+    }
+
+    inline static simd_word tile8(uint8_t pattern) {
+        return {wasm_i8x16_splat((int8_t)pattern)};
+    }
+
+    inline static simd_word tile16(uint16_t pattern) {
+        return {wasm_i16x8_splat((int16_t)pattern)};
+    }
+
+    inline static simd_word tile32(uint32_t pattern) {
+        return {wasm_i32x4_splat((int32_t)pattern)};
+    }
+
+    inline static simd_word tile64(uint64_t pattern) {
+        return {wasm_i64x2_splat((int64_t)pattern)};
+    }
+
+    inline operator bool() const {  // NOLINT(hicpp-explicit-conversions)
+        return u64[0] | u64[1];
+    }
+
+    inline simd_word &operator^=(const simd_word &other) {
+        val = wasm_v128_xor(val, other.val);
+        return *this;
+    }
+
+    inline simd_word &operator&=(const simd_word &other) {
+        val = wasm_v128_and(val, other.val);
+        return *this;
+    }
+
+    inline simd_word &operator|=(const simd_word &other) {
+        val = wasm_v128_or(val, other.val);
+        return *this;
+    }
+
+    inline simd_word operator^(const simd_word &other) const {
+        return {wasm_v128_xor(val, other.val)};
+    }
+
+    inline simd_word operator&(const simd_word &other) const {
+        return {wasm_v128_and(val, other.val)};
+    }
+
+    inline simd_word operator|(const simd_word &other) const {
+        return {wasm_v128_or(val, other.val)};
+    }
+
+    inline simd_word andnot(const simd_word &other) const {
+        // Note: wasm_v128_andnot(a, b) is a & ~b, which is the reverse of _mm_andnot_si128(a, b) = ~a & b.
+        return {wasm_v128_andnot(other.val, val)};
+    }
+
+    inline simd_word leftshift_tile64(uint8_t offset) const {
+        return {wasm_i64x2_shl(val, offset)};
+    }
+
+    inline simd_word rightshift_tile64(uint8_t offset) const {
+        return {wasm_u64x2_shr(val, offset)};
+    }
+
+    inline uint16_t popcount() const {
+        return popcnt64(u64[0]) + popcnt64(u64[1]);
+    }
+
+    /// For each 128 bit word pair between the two registers, the byte order goes from this:
+    /// [a0 a1 a2 a3 ... a14 a15] [b0 b1 b2 b3 ... b14 b15]
+    /// to this:
+    /// [a0 b0 a1 b1 ...  a7  b7] [a8 b8 a9 b9 ... a15 b15]
+    inline void do_interleave8_tile128(simd_word &other) {
+        auto t = wasm_i8x16_shuffle(val, other.val, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+        val = wasm_i8x16_shuffle(val, other.val, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        other.val = t;
+    }
+};
+
+}  // namespace stim_internal
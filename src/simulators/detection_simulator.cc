@@ -14,49 +14,62 @@
 
 #include "detection_simulator.h"
 
+#include <memory>
+
+#include "../memory_budget.h"
+#include "detector_xor_program.h"
 #include "frame_simulator.h"
 
 using namespace stim_internal;
 
-template <typename T>
-void xor_measurement_set_into_result(
-    const T &measurement_set, simd_bit_table &frame_samples, simd_bit_table &output, size_t &output_index_ticker) {
-    simd_bits_range_ref dst = output[output_index_ticker++];
-    for (auto i : measurement_set) {
-        dst ^= frame_samples[i];
-    }
-}
-
 simd_bit_table stim_internal::detector_samples(
     const Circuit &circuit,
-    const DetectorsAndObservables &det_obs,
+    const DetectorXorProgram &program,
     size_t num_shots,
     bool prepend_observables,
     bool append_observables,
     std::mt19937_64 &rng) {
-    // Start from measurement samples.
-    simd_bit_table frame_samples = FrameSimulator::sample_flipped_measurements(circuit, num_shots, rng);
-
-    auto num_detectors = det_obs.detectors.size();
-    auto num_obs = det_obs.observables.size();
+    auto num_detectors = program.num_detectors;
+    auto num_obs = program.num_observables;
     size_t num_results = num_detectors + num_obs * (prepend_observables + append_observables);
     simd_bit_table result(num_results, num_shots);
+    size_t detector_offset = prepend_observables ? num_obs : 0;
+    size_t appended_observable_offset = detector_offset + num_detectors;
 
-    // Xor together measurement samples to form detector samples.
-    size_t offset = 0;
-    if (prepend_observables) {
-        for (const auto &obs : det_obs.observables) {
-            xor_measurement_set_into_result(obs, frame_samples, result, offset);
-        }
-    }
-    for (const auto &det : det_obs.detectors) {
-        xor_measurement_set_into_result(det, frame_samples, result, offset);
-    }
-    if (append_observables) {
-        for (const auto &obs : det_obs.observables) {
-            xor_measurement_set_into_result(obs, frame_samples, result, offset);
+    // Xor together measurement samples to form detector samples as the simulation runs, instead of recording every
+    // measurement. Only results within the circuit's max lookback are kept by the measurement record.
+    FrameSimulator sim(circuit.count_qubits(), num_shots, circuit.max_lookback(), rng);
+    sim.reset_all();
+    size_t detector_index = 0;
+    program.for_each_operation(circuit, [&](const Operation &op, const DetectorXorProgram::DetectorTemplate *detector) {
+        if (detector != nullptr) {
+            program.compute_detector(
+                *detector,
+                detector_index,
+                result[detector_offset + detector_index],
+                [&](size_t j) {
+                    return result[detector_offset + j];
+                },
+                [&](size_t lookback) {
+                    return sim.m_record.lookback(lookback);
+                });
+            detector_index++;
+        } else if (op.gate->id == gate_name_to_id("OBSERVABLE_INCLUDE")) {
+            size_t id = (size_t)op.target_data.args[0];
+            for (auto t : op.target_data.targets) {
+                simd_bits_range_ref src = sim.m_record.lookback(t.data ^ TARGET_RECORD_BIT);
+                if (prepend_observables) {
+                    result[id] ^= src;
+                }
+                if (append_observables) {
+                    result[appended_observable_offset + id] ^= src;
+                }
+            }
+        } else {
+            sim.do_gate(op);
+            sim.m_record.mark_all_as_written();
         }
-    }
+    });
 
     return result;
 }
@@ -64,37 +77,67 @@ simd_bit_table stim_internal::detector_samples(
 simd_bit_table stim_internal::detector_samples(
     const Circuit &circuit, size_t num_shots, bool prepend_observables, bool append_observables, std::mt19937_64 &rng) {
     return detector_samples(
-        circuit, DetectorsAndObservables(circuit), num_shots, prepend_observables, append_observables, rng);
+        circuit, DetectorXorProgram(circuit), num_shots, prepend_observables, append_observables, rng);
 }
 
 void detector_sample_out_helper_stream(
     const Circuit &circuit,
+    const DetectorXorProgram &program,
     FrameSimulator &sim,
     size_t num_samples,
+    bool prepend_observables,
     bool append_observables,
     FILE *out,
     SampleFormat format) {
     MeasureRecordBatchWriter writer(out, num_samples, format);
     std::vector<simd_bits> observables;
     sim.reset_all();
-    writer.begin_result_type('D');
-    simd_bit_table detector_buffer(1024, num_samples);
+    constexpr size_t BLOCK = DetectorXorProgram::DETECTOR_BLOCK_SIZE;
+    simd_bit_table detector_buffer(BLOCK, num_samples);
     size_t buffered_detectors = 0;
-    circuit.for_each_operation([&](const Operation &op) {
-        if (op.gate->id == gate_name_to_id("DETECTOR")) {
-            simd_bits_range_ref result = detector_buffer[buffered_detectors];
-            result.clear();
-            for (auto t : op.target_data.targets) {
-                assert(t.data & TARGET_RECORD_BIT);
-                result ^= sim.m_record.lookback(t.data ^ TARGET_RECORD_BIT);
-            }
+    size_t detector_index = 0;
+
+    // Prepended observables aren't known until the simulation finishes, so full blocks of detector data are staged in
+    // a temporary file and written out after the observables. This keeps memory usage bounded by the block size.
+    // The file is closed (and its disk space released) when the holder goes out of scope, including on exceptions.
+    std::unique_ptr<FILE, int (*)(FILE *)> staged_blocks(nullptr, &fclose);
+    if (prepend_observables) {
+        staged_blocks.reset(tmpfile());
+        if (staged_blocks == nullptr) {
+            throw std::out_of_range("Failed to open a temp file.");
+        }
+    } else {
+        writer.begin_result_type('D');
+    }
+
+    program.for_each_operation(circuit, [&](const Operation &op, const DetectorXorProgram::DetectorTemplate *detector) {
+        if (detector != nullptr) {
+            // Detectors only reuse earlier detectors from the same block, which are still in the buffer.
+            program.compute_detector(
+                *detector,
+                detector_index,
+                detector_buffer[buffered_detectors],
+                [&](size_t j) {
+                    return detector_buffer[j % BLOCK];
+                },
+                [&](size_t lookback) {
+                    return sim.m_record.lookback(lookback);
+                });
+            detector_index++;
             buffered_detectors++;
-            if (buffered_detectors == 1024) {
-                writer.batch_write_bytes(detector_buffer, 1024 >> 6);
+            if (buffered_detectors == BLOCK) {
+                if (staged_blocks == nullptr) {
+                    writer.batch_write_bytes(detector_buffer, BLOCK >> 6);
+                } else {
+                    size_t n = detector_buffer.data.num_u8_padded();
+                    if (fwrite(detector_buffer.data.u8, 1, n, staged_blocks.get()) != n) {
+                        throw std::out_of_range("Failed to write to a temp file.");
+                    }
+                }
                 buffered_detectors = 0;
             }
         } else if (op.gate->id == gate_name_to_id("OBSERVABLE_INCLUDE")) {
-            if (append_observables) {
+            if (prepend_observables || append_observables) {
                 size_t id = (size_t)op.target_data.args[0];
                 while (observables.size() <= id) {
                     observables.emplace_back(num_samples);
@@ -107,58 +150,74 @@ void detector_sample_out_helper_stream(
                 }
             }
         } else {
-            (sim.*op.gate->frame_simulator_function)(op.target_data);
+            sim.do_gate(op);
             sim.m_record.mark_all_as_written();
         }
     });
+
+    if (staged_blocks != nullptr) {
+        writer.begin_result_type('L');
+        for (const auto &result : observables) {
+            writer.batch_write_bit(result);
+        }
+        writer.begin_result_type('D');
+        rewind(staged_blocks.get());
+        simd_bit_table staged_block(BLOCK, num_samples);
+        size_t n = staged_block.data.num_u8_padded();
+        for (size_t k = 0; k < detector_index / BLOCK; k++) {
+            if (fread(staged_block.data.u8, 1, n, staged_blocks.get()) != n) {
+                throw std::out_of_range("Failed to read from a temp file.");
+            }
+            writer.batch_write_bytes(staged_block, BLOCK >> 6);
+        }
+    }
     for (size_t k = 0; k < buffered_detectors; k++) {
         writer.batch_write_bit(detector_buffer[k]);
     }
-    writer.begin_result_type('L');
-    for (const auto &result : observables) {
-        writer.batch_write_bit(result);
+    if (staged_blocks == nullptr) {
+        writer.begin_result_type('L');
+        for (const auto &result : observables) {
+            writer.batch_write_bit(result);
+        }
     }
     writer.write_end();
 }
 
 void detector_samples_out_in_memory(
     const Circuit &circuit,
+    const DetectorXorProgram &program,
     size_t num_shots,
     bool prepend_observables,
     bool append_observables,
     FILE *out,
     SampleFormat format,
     std::mt19937_64 &rng) {
-    if (prepend_observables && append_observables) {
-        throw std::out_of_range("Can't have both --prepend_observables and --append_observables");
-    }
-
-    DetectorsAndObservables det_obs(circuit);
     size_t num_sample_locations =
-        det_obs.detectors.size() + det_obs.observables.size() * ((int)prepend_observables + (int)append_observables);
+        program.num_detectors + program.num_observables * ((int)prepend_observables + (int)append_observables);
 
     char c1, c2;
     size_t ct;
     if (prepend_observables) {
         c1 = 'L';
         c2 = 'D';
-        ct = det_obs.observables.size();
+        ct = program.num_observables;
     } else if (append_observables) {
         c1 = 'D';
         c2 = 'L';
-        ct = det_obs.detectors.size();
+        ct = program.num_detectors;
     } else {
         c1 = 'D';
         c2 = 'D';
         ct = 0;
     }
 
-    auto table = detector_samples(circuit, det_obs, num_shots, prepend_observables, append_observables, rng);
+    auto table = detector_samples(circuit, program, num_shots, prepend_observables, append_observables, rng);
     write_table_data(out, num_shots, num_sample_locations, simd_bits(0), table, format, c1, c2, ct);
 }
 
 void detector_sample_out_helper(
     const Circuit &circuit,
+    const DetectorXorProgram &program,
     FrameSimulator &sim,
     size_t num_shots,
     bool prepend_observables,
@@ -166,12 +225,14 @@ void detector_sample_out_helper(
     FILE *out,
     SampleFormat format,
     std::mt19937_64 &rng) {
-    uint64_t d = circuit.count_detectors() + circuit.num_observables();
-    uint64_t approx_mem_usage = std::max(num_shots, size_t{256}) * std::max(circuit.count_measurements(), d);
-    if (!prepend_observables && should_use_streaming_instead_of_memory(approx_mem_usage)) {
-        detector_sample_out_helper_stream(circuit, sim, num_shots, append_observables, out, format);
+    uint64_t d = program.num_detectors + program.num_observables;
+    uint64_t approx_mem_usage = std::max(num_shots, size_t{256}) * (d + 2 * circuit.max_lookback());
+    if (should_use_streaming_instead_of_memory(approx_mem_usage)) {
+        detector_sample_out_helper_stream(
+            circuit, program, sim, num_shots, prepend_observables, append_observables, out, format);
     } else {
-        detector_samples_out_in_memory(circuit, num_shots, prepend_observables, append_observables, out, format, rng);
+        detector_samples_out_in_memory(
+            circuit, program, num_shots, prepend_observables, append_observables, out, format, rng);
     }
 }
 
@@ -183,19 +244,39 @@ void stim_internal::detector_samples_out(
     FILE *out,
     SampleFormat format,
     std::mt19937_64 &rng) {
-    constexpr size_t GOOD_BLOCK_SIZE = 768;
+    // Compile the detectors once, instead of once per block of shots.
+    detector_samples_out(
+        circuit, DetectorXorProgram(circuit), num_shots, prepend_observables, append_observables, out, format, rng);
+}
+
+void stim_internal::detector_samples_out(
+    const Circuit &circuit,
+    const DetectorXorProgram &program,
+    size_t num_shots,
+    bool prepend_observables,
+    bool append_observables,
+    FILE *out,
+    SampleFormat format,
+    std::mt19937_64 &rng) {
+    if (prepend_observables && append_observables) {
+        throw std::out_of_range("Can't have both --prepend_observables and --append_observables");
+    }
     size_t num_qubits = circuit.count_qubits();
     size_t max_lookback = circuit.max_lookback();
-    if (num_shots >= GOOD_BLOCK_SIZE) {
-        auto sim = FrameSimulator(num_qubits, GOOD_BLOCK_SIZE, max_lookback, rng);
-        while (num_shots > GOOD_BLOCK_SIZE) {
+    size_t batch_size = memory_limited_shot_batch_size(
+        2 * (uint64_t)num_qubits + 2 * (uint64_t)max_lookback + DetectorXorProgram::DETECTOR_BLOCK_SIZE +
+        program.num_observables);
+    if (num_shots >= batch_size) {
+        auto sim = FrameSimulator(num_qubits, batch_size, max_lookback, rng);
+        while (num_shots > batch_size) {
             detector_sample_out_helper(
-                circuit, sim, GOOD_BLOCK_SIZE, prepend_observables, append_observables, out, format, rng);
-            num_shots -= GOOD_BLOCK_SIZE;
+                circuit, program, sim, batch_size, prepend_observables, append_observables, out, format, rng);
+            num_shots -= batch_size;
         }
     }
     if (num_shots) {
         auto sim = FrameSimulator(num_qubits, num_shots, max_lookback, rng);
-        detector_sample_out_helper(circuit, sim, num_shots, prepend_observables, append_observables, out, format, rng);
+        detector_sample_out_helper(
+            circuit, program, sim, num_shots, prepend_observables, append_observables, out, format, rng);
     }
 }
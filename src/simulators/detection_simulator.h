@@ -21,6 +21,7 @@
 
 #include "../circuit/circuit.h"
 #include "../simd/simd_bit_table.h"
+#include "detector_xor_program.h"
 
 namespace stim_internal {
 
@@ -40,12 +41,12 @@ simd_bit_table detector_samples(
 
 /// Samples detection events from the circuit and returns them in a simd_bit_table.
 ///
-/// This is a specialization of the method that takes pre-analyzed detector and observable data, so that it does not
-/// need to be recomputed repeatedly when taking multiple batches of shots.
+/// This is a specialization of the method that takes a pre-compiled detector program, so that it does not need to be
+/// recomputed repeatedly when taking multiple batches of shots.
 ///
 /// Args:
 ///     circuit: The circuit to sample.
-///     det_obs: Pre-analyzed detector and observable data for the circuit.
+///     program: The circuit's compiled detectors.
 ///     num_shots: The number of samples to take.
 ///     prepend_observables: Include the observables in the output, before the detectors.
 ///     append_observables: Include the observables in the output, after the detectors.
@@ -55,7 +56,7 @@ simd_bit_table detector_samples(
 ///     A simd_bit_table with detector/observable index as the major index and shot index as the minor index.
 simd_bit_table detector_samples(
     const Circuit &circuit,
-    const DetectorsAndObservables &det_obs,
+    const DetectorXorProgram &program,
     size_t num_shots,
     bool prepend_observables,
     bool append_observables,
@@ -83,6 +84,20 @@ void detector_samples_out(
     SampleFormat format,
     std::mt19937_64 &rng);
 
+/// Samples detection events from the circuit and writes them to a file.
+///
+/// This is a specialization of the method that takes a pre-compiled detector program, so that it does not need to be
+/// recomputed when sampling the same circuit repeatedly.
+void detector_samples_out(
+    const Circuit &circuit,
+    const DetectorXorProgram &program,
+    size_t num_shots,
+    bool prepend_observables,
+    bool append_observables,
+    FILE *out,
+    SampleFormat format,
+    std::mt19937_64 &rng);
+
 }  // namespace stim_internal
 
 #endif
@@ -40,6 +40,36 @@ TEST(DetectionSimulator, bad_detector) {
     ASSERT_THROW({ detector_samples(Circuit("rec[-1]"), 5, false, false, SHARED_TEST_RNG()); }, std::invalid_argument);
 }
 
+TEST(DetectionSimulator, detector_samples_long_circuit_observables) {
+    auto circuit = Circuit(R"CIRCUIT(
+        R 0
+        REPEAT 1000 {
+            X_ERROR(1) 0
+            M 0
+            DETECTOR rec[-1]
+        }
+        OBSERVABLE_INCLUDE(1) rec[-1] rec[-2]
+    )CIRCUIT");
+
+    auto r = detector_samples(circuit, 5, true, true, SHARED_TEST_RNG());
+    for (size_t s = 0; s < 5; s++) {
+        ASSERT_EQ(r[0][s], false);
+        ASSERT_EQ(r[1][s], true);
+        for (size_t k = 0; k < 1000; k++) {
+            ASSERT_EQ(r[2 + k][s], k % 2 == 0) << k;
+        }
+        ASSERT_EQ(r[1002][s], false);
+        ASSERT_EQ(r[1003][s], true);
+    }
+
+    auto r2 = detector_samples(circuit, 5, false, false, SHARED_TEST_RNG());
+    for (size_t s = 0; s < 5; s++) {
+        for (size_t k = 0; k < 1000; k++) {
+            ASSERT_EQ(r2[k][s], r[2 + k][s]) << k;
+        }
+    }
+}
+
 TEST(DetectionSimulator, detector_samples_out) {
     auto circuit = Circuit(R"circuit(
         X_ERROR(1) 0
@@ -99,6 +129,35 @@ TEST(DetectionSimulator, stream_many_shots) {
     }
 }
 
+TEST(DetectionSimulator, stream_matches_memory) {
+    // Enough detectors to span multiple blocks of streamed detector data.
+    auto circuit = Circuit(R"circuit(
+        REPEAT 700 {
+            X_ERROR(1) 0
+            M 0 1
+            DETECTOR rec[-2]
+            DETECTOR rec[-1]
+            OBSERVABLE_INCLUDE(2) rec[-2]
+        }
+        OBSERVABLE_INCLUDE(0) rec[-2]
+    )circuit");
+    for (auto format : {SAMPLE_FORMAT_01, SAMPLE_FORMAT_B8, SAMPLE_FORMAT_PTB64, SAMPLE_FORMAT_HITS,
+                        SAMPLE_FORMAT_R8, SAMPLE_FORMAT_DETS}) {
+        for (auto prepend_append : std::vector<std::pair<bool, bool>>{{false, false}, {true, false}, {false, true}}) {
+            bool prepend = prepend_append.first;
+            bool append = prepend_append.second;
+            FILE *tmp = tmpfile();
+            detector_samples_out(circuit, 128, prepend, append, tmp, format, SHARED_TEST_RNG());
+            auto expected = rewind_read_all(tmp);
+
+            DebugForceResultStreamingRaii force_streaming;
+            tmp = tmpfile();
+            detector_samples_out(circuit, 128, prepend, append, tmp, format, SHARED_TEST_RNG());
+            ASSERT_EQ(rewind_read_all(tmp), expected) << format << prepend << append;
+        }
+    }
+}
+
 TEST(DetectionSimulator, block_results_single_shot) {
     auto circuit = Circuit(R"circuit(
         REPEAT 10000 {
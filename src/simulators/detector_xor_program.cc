@@ -0,0 +1,223 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "detector_xor_program.h"
+
+#include <algorithm>
+
+using namespace stim_internal;
+
+/// The number of words combined at a time when there are too many sources to combine in one pass. Small enough that
+/// the chunk of the destination stays in the L1 cache while each group of sources is xored into it.
+constexpr size_t XOR_CHUNK_WORDS = 128;
+
+template <size_t N, bool OVERWRITE>
+static void xor_fixed_rows_into(simd_word *dst, const simd_word *const *srcs, size_t start, size_t end) {
+    for (size_t w = start; w < end; w++) {
+        simd_word acc = OVERWRITE ? srcs[0][w] : dst[w] ^ srcs[0][w];
+        for (size_t k = 1; k < N; k++) {
+            acc ^= srcs[k][w];
+        }
+        dst[w] = acc;
+    }
+}
+
+void stim_internal::xor_rows_into(simd_bits_range_ref dst, ConstPointerRange<const simd_word *> srcs) {
+    size_t n = dst.num_simd_words;
+    switch (srcs.size()) {
+        case 0:
+            dst.clear();
+            return;
+        case 1:
+            xor_fixed_rows_into<1, true>(dst.ptr_simd, srcs.ptr_start, 0, n);
+            return;
+        case 2:
+            xor_fixed_rows_into<2, true>(dst.ptr_simd, srcs.ptr_start, 0, n);
+            return;
+        case 3:
+            xor_fixed_rows_into<3, true>(dst.ptr_simd, srcs.ptr_start, 0, n);
+            return;
+        case 4:
+            xor_fixed_rows_into<4, true>(dst.ptr_simd, srcs.ptr_start, 0, n);
+            return;
+        default:
+            break;
+    }
+
+    // Combine the sources in groups of 4, a chunk of words at a time, so the chunk of the destination being
+    // accumulated stays in cache instead of being read and written back to memory once per group.
+    size_t num_srcs = srcs.size();
+    for (size_t start = 0; start < n; start += XOR_CHUNK_WORDS) {
+        size_t end = std::min(start + XOR_CHUNK_WORDS, n);
+        xor_fixed_rows_into<4, true>(dst.ptr_simd, srcs.ptr_start, start, end);
+        size_t k = 4;
+        for (; k + 4 <= num_srcs; k += 4) {
+            xor_fixed_rows_into<4, false>(dst.ptr_simd, srcs.ptr_start + k, start, end);
+        }
+        switch (num_srcs - k) {
+            case 1:
+                xor_fixed_rows_into<1, false>(dst.ptr_simd, srcs.ptr_start + k, start, end);
+                break;
+            case 2:
+                xor_fixed_rows_into<2, false>(dst.ptr_simd, srcs.ptr_start + k, start, end);
+                break;
+            case 3:
+                xor_fixed_rows_into<3, false>(dst.ptr_simd, srcs.ptr_start + k, start, end);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void DetectorXorProgram::flush(simd_bits_range_ref dst, ConstPointerRange<const simd_word *> srcs, bool overwrite) {
+    if (overwrite) {
+        xor_rows_into(dst, srcs);
+        return;
+    }
+    const simd_word *with_dst[17];
+    with_dst[0] = dst.ptr_simd;
+    std::copy(srcs.begin(), srcs.end(), &with_dst[1]);
+    xor_rows_into(dst, {&with_dst[0], &with_dst[srcs.size() + 1]});
+}
+
+namespace {
+
+/// An earlier detector, in the same loop iteration, that a later detector could be computed from.
+struct BaseCandidate {
+    /// The number of detectors declared in the loop iteration before this one.
+    uint64_t detector;
+    /// The measurements whose parity the detector checks, relative to the start of the loop iteration.
+    std::vector<int64_t> measurements;
+};
+
+struct DetectorXorCompiler {
+    std::vector<DetectorXorProgram::DetectorTemplate> &templates;
+    uint64_t &num_observables;
+    size_t search_window;
+    uint64_t max_lookback;
+
+    /// Checks the lookbacks of an instruction against the number of measurements made before its first execution.
+    void check_lookbacks(const Operation &op, uint64_t first_tick) const {
+        for (auto t : op.target_data.targets) {
+            uint64_t dt = t.data ^ TARGET_RECORD_BIT;
+            if (!dt) {
+                throw std::invalid_argument("Record lookback can't be 0 (unspecified).");
+            }
+            if (dt > first_tick) {
+                throw std::invalid_argument("Referred to a measurement result before the beginning of time.");
+            }
+        }
+    }
+
+    /// Compiles the templates of the detectors in a block.
+    ///
+    /// Args:
+    ///     block: The circuit or loop body to compile.
+    ///     first_tick: The number of measurements made before the first iteration of the block.
+    void compile_block(const Circuit &block, uint64_t first_tick) {
+        uint64_t tick = 0;
+        uint64_t detector = 0;
+        std::vector<BaseCandidate> candidates;
+        std::vector<int64_t> diff;
+        for (const auto &op : block.operations) {
+            if (op.gate->id == gate_name_to_id("REPEAT")) {
+                const auto &body = block.blocks[op.target_data.targets[0].data];
+                uint64_t repeats = op_data_rep_count(op.target_data);
+                compile_block(body, first_tick + tick);
+                tick = add_saturate(tick, mul_saturate(body.count_measurements(), repeats));
+                detector = add_saturate(detector, mul_saturate(body.count_detectors(), repeats));
+            } else if (op.gate->flags & GATE_PRODUCES_NOISY_RESULTS) {
+                tick += op.count_measurement_results();
+            } else if (op.gate->id == gate_name_to_id("DETECTOR")) {
+                check_lookbacks(op, first_tick + tick);
+                BaseCandidate next{detector, {}};
+                for (auto t : op.target_data.targets) {
+                    next.measurements.push_back((int64_t)tick - (int64_t)(t.data ^ TARGET_RECORD_BIT));
+                }
+                std::sort(next.measurements.begin(), next.measurements.end());
+                std::vector<int64_t> reduced;
+                for (auto m : next.measurements) {
+                    if (!reduced.empty() && reduced.back() == m) {
+                        reduced.pop_back();
+                    } else {
+                        reduced.push_back(m);
+                    }
+                }
+                next.measurements = std::move(reduced);
+
+                DetectorXorProgram::DetectorTemplate result{{}, 0, {}};
+                for (auto m : next.measurements) {
+                    result.lookbacks.push_back((uint64_t)((int64_t)tick - m));
+                }
+
+                // Look for an earlier detector that can be used as a partial sum.
+                const BaseCandidate *best = nullptr;
+                size_t best_cost = next.measurements.size();
+                for (const auto &c : candidates) {
+                    if (detector - c.detector >= DetectorXorProgram::DETECTOR_BLOCK_SIZE) {
+                        continue;
+                    }
+                    diff.clear();
+                    std::set_symmetric_difference(
+                        next.measurements.begin(),
+                        next.measurements.end(),
+                        c.measurements.begin(),
+                        c.measurements.end(),
+                        std::back_inserter(diff));
+                    if (diff.size() + 1 < best_cost &&
+                        (diff.empty() || (uint64_t)((int64_t)tick - diff.front()) <= max_lookback)) {
+                        best = &c;
+                        best_cost = diff.size() + 1;
+                    }
+                }
+                if (best != nullptr) {
+                    result.base_distance = detector - best->detector;
+                    diff.clear();
+                    std::set_symmetric_difference(
+                        next.measurements.begin(),
+                        next.measurements.end(),
+                        best->measurements.begin(),
+                        best->measurements.end(),
+                        std::back_inserter(diff));
+                    for (auto m : diff) {
+                        result.base_lookbacks.push_back((uint64_t)((int64_t)tick - m));
+                    }
+                }
+                templates.push_back(std::move(result));
+
+                candidates.push_back(std::move(next));
+                if (candidates.size() > search_window) {
+                    candidates.erase(candidates.begin());
+                }
+                detector++;
+            } else if (op.gate->id == gate_name_to_id("OBSERVABLE_INCLUDE")) {
+                check_lookbacks(op, first_tick + tick);
+                uint64_t obs = (uint64_t)op.target_data.args[0];
+                if (obs != op.target_data.args[0]) {
+                    throw std::invalid_argument("Observable index must be an integer.");
+                }
+                num_observables = std::max(num_observables, obs + 1);
+            }
+        }
+    }
+};
+
+}  // namespace
+
+DetectorXorProgram::DetectorXorProgram(const Circuit &circuit, size_t search_window)
+    : num_detectors(circuit.count_detectors()), num_observables(0) {
+    DetectorXorCompiler compiler{templates, num_observables, search_window, circuit.max_lookback()};
+    compiler.compile_block(circuit, 0);
+}
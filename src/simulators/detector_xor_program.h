@@ -0,0 +1,156 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STIM_DETECTOR_XOR_PROGRAM_H
+#define STIM_DETECTOR_XOR_PROGRAM_H
+
+#include "../circuit/circuit.h"
+#include "../simd/simd_bits_range_ref.h"
+
+namespace stim_internal {
+
+/// Overwrites a row with the xor of several rows, reading each source once and writing the destination once.
+///
+/// This is faster than clearing the destination and then xoring the sources into it one by one, which reads and
+/// writes the destination once per source. Up to 4 sources are combined in a single pass. More sources are combined
+/// in groups of 4, a cache-sized chunk of words at a time, so the destination is still only read from and written to
+/// memory once (the repeated accesses to each chunk hit the cache).
+///
+/// The first source may be the destination itself, which xors the other sources into the destination.
+void xor_rows_into(simd_bits_range_ref dst, ConstPointerRange<const simd_word *> srcs);
+
+/// A compiled plan for computing a circuit's detectors from its measurement results.
+///
+/// The plan is loop aware: it has one template per DETECTOR instruction in the circuit, with the contents of each
+/// REPEAT block compiled once. A template refers to measurements by lookback, relative to the number of measurements
+/// made before the detector is declared, so the same template works for every iteration of the enclosing loops and
+/// the program can be run while a simulator's measurement record is still being filled. The size of the program is
+/// proportional to the size of the circuit, instead of to the number of detectors in the circuit.
+///
+/// A template can also say how to compute the detector from an earlier detector in the same loop iteration, by xoring
+/// in the measurements where the two detectors differ. This is used when it reads fewer rows, which is common when
+/// neighboring detectors compare overlapping rounds of measurements. Earlier detectors are only used when they're in
+/// the same block of DETECTOR_BLOCK_SIZE detectors, so detectors can be streamed out a block at a time.
+struct DetectorXorProgram {
+    /// Detectors are only built from earlier detectors in the same aligned block of this many detectors.
+    static constexpr size_t DETECTOR_BLOCK_SIZE = 1024;
+
+    /// How to compute the detectors declared by one DETECTOR instruction.
+    struct DetectorTemplate {
+        /// The lookbacks of the measurements whose parity the detector checks. Repeated measurements cancel out.
+        std::vector<uint64_t> lookbacks;
+        /// When not zero, the detector is also equal to the detector declared this many detectors earlier xored with
+        /// the measurements in `base_lookbacks`.
+        uint64_t base_distance;
+        std::vector<uint64_t> base_lookbacks;
+    };
+
+    /// One template per DETECTOR instruction, in the order the instructions appear in the circuit (with the
+    /// instructions in each REPEAT block appearing once).
+    std::vector<DetectorTemplate> templates;
+    /// The number of detectors the circuit declares, counting each loop iteration.
+    uint64_t num_detectors;
+    /// The number of observables the circuit declares.
+    uint64_t num_observables;
+
+    /// Compiles a program for the given circuit's detectors.
+    ///
+    /// Args:
+    ///     circuit: The circuit whose detectors are being computed.
+    ///     search_window: The number of preceding detectors to consider reusing as partial sums.
+    ///
+    /// Raises:
+    ///     std::invalid_argument: A detector or observable refers to a measurement before the beginning of time.
+    explicit DetectorXorProgram(const Circuit &circuit, size_t search_window = 32);
+
+    /// Iterates over the circuit's operations, like Circuit::for_each_operation, noting the template of each detector.
+    ///
+    /// Args:
+    ///     circuit: The circuit the program was compiled from.
+    ///     callback: Called with each operation and, if the operation is a DETECTOR instruction, its template. The
+    ///         template is nullptr for other operations.
+    template <typename CALLBACK>
+    void for_each_operation(const Circuit &circuit, const CALLBACK &callback) const {
+        size_t next_template = 0;
+        for_each_operation_helper(circuit, next_template, callback);
+        assert(next_template == templates.size());
+    }
+
+    /// Computes a detector's value into the given destination row.
+    ///
+    /// Args:
+    ///     detector: The template of the DETECTOR instruction that declared the detector.
+    ///     detector_index: The index of the detector, counting each loop iteration.
+    ///     dst: Where to write the detector's value.
+    ///     detector_row: Takes an earlier detector's index and returns a reference to its computed row.
+    ///     measurement_row: Takes a lookback and returns a reference to that measurement's row.
+    template <typename DETECTOR_ROW, typename MEASUREMENT_ROW>
+    void compute_detector(
+        const DetectorTemplate &detector,
+        uint64_t detector_index,
+        simd_bits_range_ref dst,
+        const DETECTOR_ROW &detector_row,
+        const MEASUREMENT_ROW &measurement_row) const {
+        const simd_word *srcs[16];
+        size_t n = 0;
+        const std::vector<uint64_t> *lookbacks = &detector.lookbacks;
+        if (detector.base_distance != 0 && detector_index % DETECTOR_BLOCK_SIZE >= detector.base_distance) {
+            simd_bits_range_ref base = detector_row(detector_index - detector.base_distance);
+            srcs[n++] = base.ptr_simd;
+            lookbacks = &detector.base_lookbacks;
+        }
+        bool overwrite = true;
+        for (auto lookback : *lookbacks) {
+            simd_bits_range_ref row = measurement_row(lookback);
+            srcs[n++] = row.ptr_simd;
+            if (n == 16) {
+                flush(dst, {&srcs[0], &srcs[n]}, overwrite);
+                overwrite = false;
+                n = 0;
+            }
+        }
+        if (n || overwrite) {
+            flush(dst, {&srcs[0], &srcs[n]}, overwrite);
+        }
+    }
+
+   private:
+    static void flush(simd_bits_range_ref dst, ConstPointerRange<const simd_word *> srcs, bool overwrite);
+
+    template <typename CALLBACK>
+    void for_each_operation_helper(const Circuit &circuit, size_t &next_template, const CALLBACK &callback) const {
+        for (const auto &op : circuit.operations) {
+            if (op.gate->id == gate_name_to_id("REPEAT")) {
+                const auto &block = circuit.blocks[op.target_data.targets[0].data];
+                uint64_t repeats = op_data_rep_count(op.target_data);
+                size_t block_start = next_template;
+                for (uint64_t k = 0; k < repeats; k++) {
+                    next_template = block_start;
+                    for_each_operation_helper(block, next_template, callback);
+                }
+            } else if (op.gate->id == gate_name_to_id("DETECTOR")) {
+                callback(op, &templates[next_template]);
+                next_template++;
+            } else {
+                callback(op, (const DetectorTemplate *)nullptr);
+            }
+        }
+    }
+};
+
+}  // namespace stim_internal
+
+#endif
@@ -0,0 +1,108 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "detector_xor_program.h"
+
+#include "../benchmark_util.h"
+#include "../gen/gen_color_code.h"
+#include "../simd/simd_bit_table.h"
+
+using namespace stim_internal;
+
+static Circuit detector_xor_benchmark_circuit() {
+    CircuitGenParameters params(31, 31, "memory_xyz");
+    return generate_color_code_circuit(params).circuit;
+}
+
+BENCHMARK(detector_xor_per_detector_loop_color_code_d31_1024_shots) {
+    auto circuit = detector_xor_benchmark_circuit();
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    auto measurements = simd_bit_table::random(circuit.count_measurements(), 1024, rng);
+    simd_bit_table detectors(circuit.count_detectors(), 1024);
+    benchmark_go([&]() {
+        uint64_t tick = 0;
+        uint64_t k = 0;
+        circuit.for_each_operation([&](const Operation &op) {
+            tick += op.count_measurement_results();
+            if (op.gate->id == gate_name_to_id("DETECTOR")) {
+                simd_bits_range_ref dst = detectors[k];
+                dst.clear();
+                for (auto t : op.target_data.targets) {
+                    dst ^= measurements[tick - (t.data ^ TARGET_RECORD_BIT)];
+                }
+                k++;
+            }
+        });
+    })
+        .goal_micros(500)
+        .show_rate("Detectors", circuit.count_detectors());
+}
+
+BENCHMARK(detector_xor_program_color_code_d31_1024_shots) {
+    auto circuit = detector_xor_benchmark_circuit();
+    DetectorXorProgram program(circuit);
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    auto measurements = simd_bit_table::random(circuit.count_measurements(), 1024, rng);
+    simd_bit_table detectors(program.num_detectors, 1024);
+    benchmark_go([&]() {
+        uint64_t tick = 0;
+        uint64_t k = 0;
+        program.for_each_operation(
+            circuit, [&](const Operation &op, const DetectorXorProgram::DetectorTemplate *detector) {
+                tick += op.count_measurement_results();
+                if (detector != nullptr) {
+                    program.compute_detector(
+                        *detector,
+                        k,
+                        detectors[k],
+                        [&](size_t j) {
+                            return detectors[j];
+                        },
+                        [&](size_t lookback) {
+                            return measurements[tick - lookback];
+                        });
+                    k++;
+                }
+            });
+    })
+        .goal_micros(450)
+        .show_rate("Detectors", program.num_detectors);
+}
+
+BENCHMARK(detector_xor_program_compile_color_code_d31) {
+    auto circuit = detector_xor_benchmark_circuit();
+    size_t total = 0;
+    benchmark_go([&]() {
+        total += DetectorXorProgram(circuit).templates.size();
+    })
+        .goal_millis(1.5)
+        .show_rate("Detectors", circuit.count_detectors());
+    if (total == 0) {
+        std::cout << "data dependence";
+    }
+}
+
+BENCHMARK(detector_xor_program_compile_color_code_d31_10K_rounds) {
+    CircuitGenParameters params(10000, 31, "memory_xyz");
+    auto circuit = generate_color_code_circuit(params).circuit;
+    size_t total = 0;
+    benchmark_go([&]() {
+        total += DetectorXorProgram(circuit).templates.size();
+    })
+        .goal_millis(1.5)
+        .show_rate("Detectors", circuit.count_detectors());
+    if (total == 0) {
+        std::cout << "data dependence";
+    }
+}
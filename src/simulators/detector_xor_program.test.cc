@@ -0,0 +1,190 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "detector_xor_program.h"
+
+#include <gtest/gtest.h>
+
+#include "../gen/gen_color_code.h"
+#include "../gen/gen_surface_code.h"
+#include "../simd/simd_bit_table.h"
+#include "../test_util.test.h"
+
+using namespace stim_internal;
+
+static void expect_program_matches_naive_xor(const Circuit &circuit) {
+    DetectorsAndObservables det_obs(circuit);
+    DetectorXorProgram program(circuit);
+    ASSERT_EQ(program.num_detectors, det_obs.detectors.size());
+    ASSERT_EQ(program.num_observables, det_obs.observables.size());
+
+    size_t num_shots = 256;
+    auto measurements = simd_bit_table::random(circuit.count_measurements(), num_shots, SHARED_TEST_RNG());
+    simd_bit_table expected(det_obs.detectors.size(), num_shots);
+    for (size_t k = 0; k < det_obs.detectors.size(); k++) {
+        for (auto m : det_obs.detectors[k]) {
+            expected[k] ^= measurements[m];
+        }
+    }
+
+    simd_bit_table actual(det_obs.detectors.size(), num_shots);
+    actual.data.randomize(actual.data.num_bits_padded(), SHARED_TEST_RNG());
+    uint64_t tick = 0;
+    uint64_t k = 0;
+    program.for_each_operation(circuit, [&](const Operation &op, const DetectorXorProgram::DetectorTemplate *detector) {
+        tick += op.count_measurement_results();
+        if (detector == nullptr) {
+            return;
+        }
+        program.compute_detector(
+            *detector,
+            k,
+            actual[k],
+            [&](size_t j) {
+                EXPECT_LT(j, k);
+                EXPECT_EQ(j / DetectorXorProgram::DETECTOR_BLOCK_SIZE, k / DetectorXorProgram::DETECTOR_BLOCK_SIZE);
+                return actual[j];
+            },
+            [&](size_t lookback) {
+                EXPECT_GE(lookback, 1);
+                EXPECT_LE(lookback, circuit.max_lookback());
+                return measurements[tick - lookback];
+            });
+        k++;
+    });
+    ASSERT_EQ(k, det_obs.detectors.size());
+    for (size_t d = 0; d < det_obs.detectors.size(); d++) {
+        ASSERT_EQ(actual[d], expected[d]) << d;
+    }
+}
+
+TEST(DetectorXorProgram, matches_naive_xor_color_code) {
+    CircuitGenParameters params(100, 5, "memory_xyz");
+    expect_program_matches_naive_xor(generate_color_code_circuit(params).circuit);
+}
+
+TEST(DetectorXorProgram, matches_naive_xor_surface_code) {
+    CircuitGenParameters params(10, 5, "rotated_memory_x");
+    expect_program_matches_naive_xor(generate_surface_code_circuit(params).circuit);
+    params.task = "unrotated_memory_z";
+    expect_program_matches_naive_xor(generate_surface_code_circuit(params).circuit);
+}
+
+TEST(DetectorXorProgram, matches_naive_xor_edge_cases) {
+    expect_program_matches_naive_xor(Circuit(R"CIRCUIT(
+        M 0 1 2 3 4 5 6 7 8 9
+        DETECTOR
+        DETECTOR rec[-1] rec[-1]
+        DETECTOR rec[-1] rec[-2] rec[-1]
+        REPEAT 20 {
+            M 0 1 2 3 4 5 6 7 8 9
+            DETECTOR rec[-1] rec[-2] rec[-3] rec[-4] rec[-5] rec[-6] rec[-7] rec[-8] rec[-9] rec[-10] rec[-11] rec[-12] rec[-13] rec[-14] rec[-15] rec[-16] rec[-17] rec[-18] rec[-19] rec[-20]
+            DETECTOR rec[-1] rec[-2] rec[-3] rec[-4] rec[-5] rec[-6] rec[-7] rec[-8] rec[-9] rec[-10] rec[-11] rec[-12] rec[-13] rec[-14] rec[-15] rec[-16] rec[-17] rec[-18] rec[-19]
+        }
+    )CIRCUIT"));
+}
+
+TEST(DetectorXorProgram, matches_naive_xor_nested_loops) {
+    expect_program_matches_naive_xor(Circuit(R"CIRCUIT(
+        M 0 1 2
+        REPEAT 3 {
+            M 0 1
+            DETECTOR rec[-1] rec[-3] rec[-5]
+            REPEAT 400 {
+                M 2 3
+                DETECTOR rec[-1] rec[-2] rec[-3]
+                DETECTOR rec[-1] rec[-2] rec[-4]
+                OBSERVABLE_INCLUDE(1) rec[-1]
+            }
+            DETECTOR rec[-1] rec[-2] rec[-3] rec[-4]
+            DETECTOR rec[-1] rec[-2] rec[-3] rec[-5]
+        }
+        DETECTOR rec[-1]
+    )CIRCUIT"));
+}
+
+TEST(DetectorXorProgram, reuses_overlapping_detectors) {
+    auto circuit = Circuit(R"CIRCUIT(
+        M 0 1 2 3 4 5
+        DETECTOR rec[-1] rec[-2] rec[-3] rec[-4] rec[-5]
+        DETECTOR rec[-1] rec[-2] rec[-3] rec[-4] rec[-6]
+        M 6
+        DETECTOR rec[-1] rec[-2] rec[-3] rec[-4] rec[-5] rec[-7]
+        DETECTOR rec[-1] rec[-2]
+    )CIRCUIT");
+    DetectorXorProgram program(circuit);
+    ASSERT_EQ(program.templates.size(), 4);
+    ASSERT_EQ(program.templates[0].lookbacks, (std::vector<uint64_t>{5, 4, 3, 2, 1}));
+    ASSERT_EQ(program.templates[0].base_distance, 0);
+    ASSERT_EQ(program.templates[1].lookbacks, (std::vector<uint64_t>{6, 4, 3, 2, 1}));
+    ASSERT_EQ(program.templates[1].base_distance, 1);
+    ASSERT_EQ(program.templates[1].base_lookbacks, (std::vector<uint64_t>{6, 5}));
+    ASSERT_EQ(program.templates[2].base_distance, 1);
+    ASSERT_EQ(program.templates[2].base_lookbacks, (std::vector<uint64_t>{1}));
+    ASSERT_EQ(program.templates[3].lookbacks, (std::vector<uint64_t>{2, 1}));
+    ASSERT_EQ(program.templates[3].base_distance, 0);
+}
+
+TEST(DetectorXorProgram, loops_compiled_once) {
+    auto circuit = Circuit(R"CIRCUIT(
+        M 0 1
+        REPEAT 1000000 {
+            M 0 1
+            DETECTOR rec[-1] rec[-3]
+            DETECTOR rec[-2] rec[-4]
+            OBSERVABLE_INCLUDE(2) rec[-1]
+        }
+    )CIRCUIT");
+    DetectorXorProgram program(circuit);
+    ASSERT_EQ(program.templates.size(), 2);
+    ASSERT_EQ(program.num_detectors, 2000000);
+    ASSERT_EQ(program.num_observables, 3);
+    ASSERT_EQ(program.templates[1].lookbacks, (std::vector<uint64_t>{4, 2}));
+}
+
+TEST(DetectorXorProgram, bad_lookbacks) {
+    ASSERT_THROW({ DetectorXorProgram(Circuit("M 0\nDETECTOR rec[-2]")); }, std::invalid_argument);
+    ASSERT_THROW({ DetectorXorProgram(Circuit("M 0\nOBSERVABLE_INCLUDE(0) rec[-2]")); }, std::invalid_argument);
+    ASSERT_THROW(
+        { DetectorXorProgram(Circuit("REPEAT 2 {\nM 0\nDETECTOR rec[-2]\n}")); }, std::invalid_argument);
+    DetectorXorProgram(Circuit("M 0\nREPEAT 2 {\nM 0\nDETECTOR rec[-2]\n}"));
+}
+
+TEST(DetectorXorProgram, xor_rows_into) {
+    // Wide enough to span several chunks of words when there are more than 4 sources.
+    size_t num_bits = 100000;
+    std::vector<simd_bits> rows;
+    for (size_t k = 0; k < 17; k++) {
+        rows.push_back(simd_bits::random(num_bits, SHARED_TEST_RNG()));
+    }
+    for (size_t n = 0; n <= rows.size(); n++) {
+        std::vector<const simd_word *> srcs;
+        simd_bits expected(num_bits);
+        for (size_t k = 0; k < n; k++) {
+            srcs.push_back(rows[k].ptr_simd);
+            expected ^= rows[k];
+        }
+        simd_bits actual = simd_bits::random(num_bits, SHARED_TEST_RNG());
+        xor_rows_into(actual, srcs);
+        ASSERT_EQ(actual, expected) << n;
+
+        // Accumulating into the destination.
+        if (n > 0) {
+            simd_bits accumulated = rows[0];
+            srcs[0] = accumulated.ptr_simd;
+            xor_rows_into(accumulated, srcs);
+            ASSERT_EQ(accumulated, expected) << n;
+        }
+    }
+}
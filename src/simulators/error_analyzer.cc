@@ -502,7 +502,7 @@ void ErrorAnalyzer::run_circuit(const Circuit &circuit) {
             }
         } else {
             try {
-                (this->*op.gate->reverse_error_analyzer_function)(op.target_data);
+                do_gate(op);
             } catch (std::invalid_argument &ex) {
                 throw std::invalid_argument(
                     std::string(ex.what()) + "\nContext: analyzing the circuit operation at offset " +
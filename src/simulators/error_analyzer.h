@@ -26,6 +26,7 @@
 
 #include "../circuit/circuit.h"
 #include "../dem/detector_error_model.h"
+#include "../profiling.h"
 #include "../simd/fixed_cap_vector.h"
 #include "../simd/monotonic_buffer.h"
 #include "../simd/simd_util.h"
@@ -121,6 +122,25 @@ struct ErrorAnalyzer {
     void ISWAP(const OperationData &dat);
 
     void run_circuit(const Circuit &circuit);
+    /// Applies an operation (in reverse) to the analyzer state.
+    inline void do_gate(const Operation &op) {
+        profiled(
+            GLOBAL_PROFILER.gates[PROFILE_ERROR_ANALYZER][op.gate->id],
+            [&]() {
+                // Each targeted qubit has a sparse X sensitivity set and a sparse Z sensitivity set.
+                uint64_t n = 0;
+                for (auto t : op.target_data.targets) {
+                    auto q = t.qubit_value();
+                    if (!(t.data & TARGET_RECORD_BIT) && q < xs.size()) {
+                        n += xs[q].sorted_items.size() + zs[q].sorted_items.size();
+                    }
+                }
+                return n * sizeof(DemTarget);
+            },
+            [&]() {
+                (this->*op.gate->reverse_error_analyzer_function)(op.target_data);
+            });
+    }
     void post_check_initialization();
 
    private:
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cstring>
 
+#include "../memory_budget.h"
 #include "../probability_util.h"
 #include "tableau_simulator.h"
 
@@ -31,7 +32,13 @@ DebugForceResultStreamingRaii::~DebugForceResultStreamingRaii() {
 }
 
 bool stim_internal::should_use_streaming_instead_of_memory(uint64_t result_count) {
-    return force_stream_count > 0 || result_count > 100000000;
+    if (force_stream_count > 0) {
+        return true;
+    }
+    if (!memory_limit_is_set()) {
+        return result_count > 100000000;
+    }
+    return (result_count >> 3) > memory_limit_bytes();
 }
 
 // Iterates over the X and Z frame components of a pair of qubits, applying a custom FUNC to each.
@@ -74,7 +81,7 @@ void FrameSimulator::reset_all() {
 void FrameSimulator::reset_all_and_run(const Circuit &circuit) {
     reset_all();
     circuit.for_each_operation([&](const Operation &op) {
-        (this->*op.gate->frame_simulator_function)(op.target_data);
+        do_gate(op);
     });
 }
 
@@ -223,72 +230,117 @@ void FrameSimulator::C_ZYX(const OperationData &target_data) {
     }
 }
 
+template <bool FLIP_X, bool FLIP_Z>
+void FrameSimulator::single_feedback(uint32_t record_target, uint32_t qubit_target) {
+    if (qubit_target & TARGET_RECORD_BIT) {
+        throw std::invalid_argument("Measurement record editing is not supported.");
+    }
+    simd_bits_range_ref record = measurement_record_ref(record_target);
+    if (FLIP_X && FLIP_Z) {
+        x_table[qubit_target].for_each_word(
+            z_table[qubit_target], record, [](simd_word &x, simd_word &z, simd_word &m) {
+                x ^= m;
+                z ^= m;
+            });
+    } else if (FLIP_X) {
+        x_table[qubit_target] ^= record;
+    } else if (FLIP_Z) {
+        z_table[qubit_target] ^= record;
+    }
+}
+
+/// Returns true if any target is a measurement record target, meaning some pairs are classically controlled.
+static bool has_record_target(const OperationData &target_data) {
+    for (auto t : target_data.targets) {
+        if (t.data & TARGET_RECORD_BIT) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <bool MAY_FEEDBACK>
 void FrameSimulator::single_cx(uint32_t c, uint32_t t) {
-    if (!((c | t) & TARGET_RECORD_BIT)) {
+    if (!MAY_FEEDBACK || !((c | t) & TARGET_RECORD_BIT)) {
         x_table[c].for_each_word(
             z_table[c], x_table[t], z_table[t], [](simd_word &x1, simd_word &z1, simd_word &x2, simd_word &z2) {
                 z1 ^= z2;
                 x2 ^= x1;
             });
-    } else if (t & TARGET_RECORD_BIT) {
-        throw std::invalid_argument("Measurement record editing is not supported.");
     } else {
-        x_table[t] ^= measurement_record_ref(c);
+        single_feedback<true, false>(c, t);
     }
 }
 
+template <bool MAY_FEEDBACK>
 void FrameSimulator::single_cy(uint32_t c, uint32_t t) {
-    if (!((c | t) & TARGET_RECORD_BIT)) {
+    if (!MAY_FEEDBACK || !((c | t) & TARGET_RECORD_BIT)) {
         x_table[c].for_each_word(
             z_table[c], x_table[t], z_table[t], [](simd_word &x1, simd_word &z1, simd_word &x2, simd_word &z2) {
                 z1 ^= x2 ^ z2;
                 z2 ^= x1;
                 x2 ^= x1;
             });
-    } else if (t & TARGET_RECORD_BIT) {
-        throw std::invalid_argument("Measurement record editing is not supported.");
     } else {
-        x_table[t].for_each_word(z_table[t], measurement_record_ref(c), [](simd_word &x, simd_word &z, simd_word &m) {
-            x ^= m;
-            z ^= m;
-        });
+        single_feedback<true, true>(c, t);
+    }
+}
+
+template <bool MAY_FEEDBACK>
+void FrameSimulator::single_cz(uint32_t c, uint32_t t) {
+    if (!MAY_FEEDBACK || !((c | t) & TARGET_RECORD_BIT)) {
+        x_table[c].for_each_word(
+            z_table[c], x_table[t], z_table[t], [](simd_word &x1, simd_word &z1, simd_word &x2, simd_word &z2) {
+                z1 ^= x2;
+                z2 ^= x1;
+            });
+    } else if (c & t & TARGET_RECORD_BIT) {
+        // No op.
+    } else if (c & TARGET_RECORD_BIT) {
+        single_feedback<false, true>(c, t);
+    } else {
+        single_feedback<false, true>(t, c);
     }
 }
 
 void FrameSimulator::ZCX(const OperationData &target_data) {
     const auto &targets = target_data.targets;
     assert((targets.size() & 1) == 0);
-    for (size_t k = 0; k < targets.size(); k += 2) {
-        single_cx(targets[k].data, targets[k + 1].data);
+    if (has_record_target(target_data)) {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cx<true>(targets[k].data, targets[k + 1].data);
+        }
+    } else {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cx<false>(targets[k].data, targets[k + 1].data);
+        }
     }
 }
 
 void FrameSimulator::ZCY(const OperationData &target_data) {
     const auto &targets = target_data.targets;
     assert((targets.size() & 1) == 0);
-    for (size_t k = 0; k < targets.size(); k += 2) {
-        single_cy(targets[k].data, targets[k + 1].data);
+    if (has_record_target(target_data)) {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cy<true>(targets[k].data, targets[k + 1].data);
+        }
+    } else {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cy<false>(targets[k].data, targets[k + 1].data);
+        }
     }
 }
 
 void FrameSimulator::ZCZ(const OperationData &target_data) {
     const auto &targets = target_data.targets;
     assert((targets.size() & 1) == 0);
-    for (size_t k = 0; k < targets.size(); k += 2) {
-        size_t c = targets[k].data;
-        size_t t = targets[k + 1].data;
-        if (!((c | t) & TARGET_RECORD_BIT)) {
-            x_table[c].for_each_word(
-                z_table[c], x_table[t], z_table[t], [](simd_word &x1, simd_word &z1, simd_word &x2, simd_word &z2) {
-                    z1 ^= x2;
-                    z2 ^= x1;
-                });
-        } else if (c & t & TARGET_RECORD_BIT) {
-            // No op.
-        } else if (c & TARGET_RECORD_BIT) {
-            z_table[t] ^= measurement_record_ref(c);
-        } else {
-            z_table[c] ^= measurement_record_ref(t);
+    if (has_record_target(target_data)) {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cz<true>(targets[k].data, targets[k + 1].data);
+        }
+    } else {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cz<false>(targets[k].data, targets[k + 1].data);
         }
     }
 }
@@ -362,8 +414,14 @@ void FrameSimulator::XCY(const OperationData &target_data) {
 void FrameSimulator::XCZ(const OperationData &target_data) {
     const auto &targets = target_data.targets;
     assert((targets.size() & 1) == 0);
-    for (size_t k = 0; k < targets.size(); k += 2) {
-        single_cx(targets[k + 1].data, targets[k].data);
+    if (has_record_target(target_data)) {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cx<true>(targets[k + 1].data, targets[k].data);
+        }
+    } else {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cx<false>(targets[k + 1].data, targets[k].data);
+        }
     }
 }
 
@@ -389,38 +447,116 @@ void FrameSimulator::YCY(const OperationData &target_data) {
 void FrameSimulator::YCZ(const OperationData &target_data) {
     const auto &targets = target_data.targets;
     assert((targets.size() & 1) == 0);
-    for (size_t k = 0; k < targets.size(); k += 2) {
-        single_cy(targets[k + 1].data, targets[k].data);
+    if (has_record_target(target_data)) {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cy<true>(targets[k + 1].data, targets[k].data);
+        }
+    } else {
+        for (size_t k = 0; k < targets.size(); k += 2) {
+            single_cy<false>(targets[k + 1].data, targets[k].data);
+        }
+    }
+}
+
+/// Producing masks costs a pass over the shots for each possible Pauli term (plus one), whereas skipping between hits
+/// costs time proportional to the number of hits. This is roughly the total probability per pass where they break even.
+constexpr double PAULI_CHANNEL_SPARSE_PROBABILITY_PER_PASS = 0.004;
+
+template <size_t Q>
+void FrameSimulator::pauli_channel(ConstPointerRange<GateTarget> targets, const double *probabilities) {
+    constexpr size_t NUM_TERMS = (1 << (2 * Q)) - 1;
+    assert(targets.size() % Q == 0);
+
+    // Clamp the probabilities the same way that a chain of else-correlated errors would.
+    double term_probabilities[NUM_TERMS];
+    double total = 0;
+    size_t num_passes = 1;
+    size_t last_term = 0;
+    for (size_t k = 0; k < NUM_TERMS; k++) {
+        term_probabilities[k] = std::max(0.0, std::min(probabilities[k], 1 - total));
+        total += term_probabilities[k];
+        if (term_probabilities[k] > 0) {
+            num_passes++;
+            last_term = k;
+        }
+    }
+    if (total == 0) {
+        return;
+    }
+    auto flip_qubits = [](size_t term, const GateTarget *group, simd_bit_table &xs, simd_bit_table &zs, size_t s) {
+        for (size_t q = 0; q < Q; q++) {
+            auto pauli = (term + 1) >> (2 * (Q - q - 1));
+            xs[group[q].data][s] ^= (bool)((pauli ^ (pauli >> 1)) & 1);
+            zs[group[q].data][s] ^= (bool)(pauli & 2);
+        }
+    };
+
+    if (total < PAULI_CHANNEL_SPARSE_PROBABILITY_PER_PASS * num_passes) {
+        // Sparse: skip between hits, then pick which Pauli term was hit.
+        double cumulative[NUM_TERMS];
+        double acc = 0;
+        for (size_t k = 0; k < NUM_TERMS; k++) {
+            acc += term_probabilities[k];
+            cumulative[k] = acc / total;
+        }
+        size_t n = targets.size() / Q * batch_size;
+        RareErrorIterator::for_samples(total, n, rng, [&](size_t s) {
+            double u = std::uniform_real_distribution<double>(0, 1)(rng);
+            size_t term = 0;
+            while (term < last_term && u >= cumulative[term]) {
+                term++;
+            }
+            flip_qubits(term, &targets[(s / batch_size) * Q], x_table, z_table, s % batch_size);
+        });
+        return;
+    }
+
+    // Dense: make a mask of shots where any error happened, then split it between the Pauli terms.
+    size_t num_words = (batch_size + 63) >> 6;
+    uint64_t tail_mask = batch_size & 63 ? (uint64_t{1} << (batch_size & 63)) - 1 : ~uint64_t{0};
+    for (size_t k = 0; k < targets.size(); k += Q) {
+        biased_randomize_bits((float)total, tmp_storage.u64, tmp_storage.u64 + num_words, rng);
+        tmp_storage.u64[num_words - 1] &= tail_mask;
+        double remaining = total;
+        for (size_t term = 0; term <= last_term; term++) {
+            double p = term_probabilities[term];
+            if (p == 0) {
+                continue;
+            }
+            if (term == last_term) {
+                rng_buffer = tmp_storage;
+            } else {
+                biased_randomize_bits((float)(p / remaining), rng_buffer.u64, rng_buffer.u64 + num_words, rng);
+                rng_buffer &= tmp_storage;
+                simd_bits_range_ref{tmp_storage}.for_each_word(rng_buffer, [](simd_word &hit, simd_word &mask) {
+                    hit = mask.andnot(hit);
+                });
+            }
+            remaining -= p;
+            for (size_t q = 0; q < Q; q++) {
+                auto pauli = (term + 1) >> (2 * (Q - q - 1));
+                auto t = targets[k + q].data;
+                if ((pauli ^ (pauli >> 1)) & 1) {
+                    x_table[t] ^= rng_buffer;
+                }
+                if (pauli & 2) {
+                    z_table[t] ^= rng_buffer;
+                }
+            }
+        }
     }
 }
 
 void FrameSimulator::DEPOLARIZE1(const OperationData &target_data) {
-    const auto &targets = target_data.targets;
-    RareErrorIterator::for_samples(target_data.args[0], targets.size() * batch_size, rng, [&](size_t s) {
-        auto p = 1 + (rng() % 3);
-        auto target_index = s / batch_size;
-        auto sample_index = s % batch_size;
-        auto t = targets[target_index];
-        x_table[t.data][sample_index] ^= p & 1;
-        z_table[t.data][sample_index] ^= p & 2;
-    });
+    double p = target_data.args[0] / 3;
+    double probabilities[3]{p, p, p};
+    pauli_channel<1>(target_data.targets, probabilities);
 }
 
 void FrameSimulator::DEPOLARIZE2(const OperationData &target_data) {
-    const auto &targets = target_data.targets;
-    assert(!(targets.size() & 1));
-    auto n = (targets.size() * batch_size) >> 1;
-    RareErrorIterator::for_samples(target_data.args[0], n, rng, [&](size_t s) {
-        auto p = 1 + (rng() % 15);
-        auto target_index = (s / batch_size) << 1;
-        auto sample_index = s % batch_size;
-        size_t t1 = targets[target_index].data;
-        size_t t2 = targets[target_index + 1].data;
-        x_table[t1][sample_index] ^= (bool)(p & 1);
-        z_table[t1][sample_index] ^= (bool)(p & 2);
-        x_table[t2][sample_index] ^= (bool)(p & 4);
-        z_table[t2][sample_index] ^= (bool)(p & 8);
-    });
+    double p = target_data.args[0] / 15;
+    double probabilities[15]{p, p, p, p, p, p, p, p, p, p, p, p, p, p, p};
+    pauli_channel<2>(target_data.targets, probabilities);
 }
 
 void FrameSimulator::X_ERROR(const OperationData &target_data) {
@@ -455,47 +591,47 @@ void FrameSimulator::Z_ERROR(const OperationData &target_data) {
 }
 
 void FrameSimulator::MPP(const OperationData &target_data) {
-    decompose_mpp_operation(
-        target_data,
-        num_qubits,
-        [&](const OperationData &h_xz,
-            const OperationData &h_yz,
-            const OperationData &cnot,
-            const OperationData &meas) {
-            H_XZ(h_xz);
-            H_YZ(h_yz);
-            ZCX(cnot);
-            measure_z(meas);
-            ZCX(cnot);
-            H_YZ(h_yz);
-            H_XZ(h_xz);
-        });
+    size_t num_products = 0;
+    for (auto t : target_data.targets) {
+        num_products += !t.is_combiner();
+        num_products -= t.is_combiner();
+    }
+    m_record.reserve_noisy_space_for_results(num_products, target_data.args, rng);
+
+    for_each_mpp_product(target_data, [&](ConstPointerRange<GateTarget> product) {
+        // The measurement is flipped by frame terms that anticommute with the observable.
+        tmp_storage.clear();
+        for (auto t : product) {
+            auto q = t.qubit_value();  // Flipping is ignored because it is accounted for in the reference sample.
+            if (t.data & TARGET_PAULI_X_BIT) {
+                tmp_storage ^= z_table[q];
+            }
+            if (t.data & TARGET_PAULI_Z_BIT) {
+                tmp_storage ^= x_table[q];
+            }
+        }
+        m_record.xor_record_reserved_result(tmp_storage);
+
+        // Randomize the gauge, by multiplying the observable into the frame of half of the shots.
+        rng_buffer.randomize(rng_buffer.num_bits_padded(), rng);
+        for (auto t : product) {
+            auto q = t.qubit_value();
+            if (t.data & TARGET_PAULI_X_BIT) {
+                x_table[q] ^= rng_buffer;
+            }
+            if (t.data & TARGET_PAULI_Z_BIT) {
+                z_table[q] ^= rng_buffer;
+            }
+        }
+    });
 }
 
 void FrameSimulator::PAULI_CHANNEL_1(const OperationData &target_data) {
-    tmp_storage = last_correlated_error_occurred;
-    perform_pauli_errors_via_correlated_errors<1>(
-        target_data,
-        [&]() {
-            last_correlated_error_occurred.clear();
-        },
-        [&](const OperationData &d) {
-            ELSE_CORRELATED_ERROR(d);
-        });
-    last_correlated_error_occurred = tmp_storage;
+    pauli_channel<1>(target_data.targets, target_data.args.begin());
 }
 
 void FrameSimulator::PAULI_CHANNEL_2(const OperationData &target_data) {
-    tmp_storage = last_correlated_error_occurred;
-    perform_pauli_errors_via_correlated_errors<2>(
-        target_data,
-        [&]() {
-            last_correlated_error_occurred.clear();
-        },
-        [&](const OperationData &d) {
-            ELSE_CORRELATED_ERROR(d);
-        });
-    last_correlated_error_occurred = tmp_storage;
+    pauli_channel<2>(target_data.targets, target_data.args.begin());
 }
 
 simd_bit_table FrameSimulator::sample_flipped_measurements(
@@ -556,14 +692,14 @@ void sample_out_helper(
         // Results getting quite large. Stream them (with buffering to disk) instead of trying to store them all.
         MeasureRecordBatchWriter writer(out, num_shots, format);
         circuit.for_each_operation([&](const Operation &op) {
-            (sim.*op.gate->frame_simulator_function)(op.target_data);
+            sim.do_gate(op);
             sim.m_record.intermediate_write_unwritten_results_to(writer, ref_sample);
         });
         sim.m_record.final_write_unwritten_results_to(writer, ref_sample);
     } else {
         // Small case. Just do everything in memory.
         circuit.for_each_operation([&](const Operation &op) {
-            (sim.*op.gate->frame_simulator_function)(op.target_data);
+            sim.do_gate(op);
         });
         write_table_data(
             out, num_shots, circuit.count_measurements(), ref_sample, sim.m_record.storage, format, 'M', 'M', 0);
@@ -577,14 +713,14 @@ void FrameSimulator::sample_out(
     FILE *out,
     SampleFormat format,
     std::mt19937_64 &rng) {
-    constexpr size_t GOOD_BLOCK_SIZE = 768;
     size_t num_qubits = circuit.count_qubits();
     size_t max_lookback = circuit.max_lookback();
-    if (num_shots >= GOOD_BLOCK_SIZE) {
-        auto sim = FrameSimulator(num_qubits, GOOD_BLOCK_SIZE, max_lookback, rng);
-        while (num_shots > GOOD_BLOCK_SIZE) {
-            sample_out_helper(circuit, sim, reference_sample, GOOD_BLOCK_SIZE, out, format);
-            num_shots -= GOOD_BLOCK_SIZE;
+    size_t batch_size = memory_limited_shot_batch_size(2 * (uint64_t)num_qubits + 2 * (uint64_t)max_lookback);
+    if (num_shots >= batch_size) {
+        auto sim = FrameSimulator(num_qubits, batch_size, max_lookback, rng);
+        while (num_shots > batch_size) {
+            sample_out_helper(circuit, sim, reference_sample, batch_size, out, format);
+            num_shots -= batch_size;
         }
     }
     if (num_shots) {
@@ -21,6 +21,7 @@
 
 #include "../circuit/circuit.h"
 #include "../io/measure_record_batch.h"
+#include "../profiling.h"
 #include "../simd/simd_bit_table.h"
 #include "../stabilizers/pauli_string.h"
 
@@ -84,6 +85,18 @@ struct FrameSimulator {
     void reset_all_and_run(const Circuit &circuit);
     void reset_all();
 
+    /// Applies an operation to the simulator state.
+    inline void do_gate(const Operation &op) {
+        profiled(
+            GLOBAL_PROFILER.gates[PROFILE_FRAME_SIMULATOR][op.gate->id],
+            [&]() {
+                return op.target_data.targets.size() * 2 * x_table.num_minor_u8_padded();
+            },
+            [&]() {
+                (this->*op.gate->frame_simulator_function)(op.target_data);
+            });
+    }
+
     void measure_x(const OperationData &target_data);
     void measure_y(const OperationData &target_data);
     void measure_z(const OperationData &target_data);
@@ -129,10 +142,31 @@ struct FrameSimulator {
 
    private:
     simd_bits_range_ref measurement_record_ref(uint32_t encoded_target);
+    /// Applies a Pauli to a qubit's frame in the shots where a recorded measurement result was flipped.
+    template <bool FLIP_X, bool FLIP_Z>
+    void single_feedback(uint32_t record_target, uint32_t qubit_target);
+    /// Applies a Pauli channel to each group of Q targets, sampling every Pauli term of the channel in one pass.
+    ///
+    /// Args:
+    ///     targets: The qubits to apply the channel to, in groups of Q.
+    ///     probabilities: The probability of each non-identity Pauli term. The term with index k-1 is encoded by k,
+    ///         using two bits per qubit (1=X, 2=Y, 3=Z) with the first qubit in the high bits.
+    template <size_t Q>
+    void pauli_channel(ConstPointerRange<GateTarget> targets, const double *probabilities);
+    /// Applies a controlled Pauli to one pair of targets.
+    ///
+    /// MAY_FEEDBACK is resolved once per operation: when it's false, neither target is a measurement record target,
+    /// and the check for classical control is compiled out of the per-pair work.
+    template <bool MAY_FEEDBACK>
     void single_cx(uint32_t c, uint32_t t);
+    template <bool MAY_FEEDBACK>
     void single_cy(uint32_t c, uint32_t t);
+    template <bool MAY_FEEDBACK>
+    void single_cz(uint32_t c, uint32_t t);
 };
 
+/// Returns true if holding the given number of result bits in memory would exceed the memory budget (see
+/// `memory_limit_bytes`), meaning results should be streamed through temporary files instead.
 bool should_use_streaming_instead_of_memory(uint64_t result_count);
 struct DebugForceResultStreamingRaii {
     DebugForceResultStreamingRaii();
@@ -94,3 +94,119 @@ BENCHMARK(FrameSimulator_CX_100Kqubits_1Ksamples) {
         .goal_millis(2)
         .show_rate("OpQubits", targets.size() * num_samples);
 }
+
+static BenchmarkResult &bench_feedback(void (FrameSimulator::*gate)(const OperationData &), bool record_first) {
+    size_t num_qubits = 100 * 1000;
+    size_t num_samples = 1000;
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    FrameSimulator sim(num_qubits, num_samples, SIZE_MAX, rng);
+
+    std::vector<GateTarget> measure_targets;
+    std::vector<GateTarget> targets;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        measure_targets.push_back({k});
+        GateTarget rec{(uint32_t)(num_qubits - k) | TARGET_RECORD_BIT};
+        GateTarget qubit{k};
+        targets.push_back(record_first ? rec : qubit);
+        targets.push_back(record_first ? qubit : rec);
+    }
+    sim.measure_z(OperationData{{}, measure_targets});
+    OperationData op_data{{}, targets};
+
+    return benchmark_go([&]() {
+               (sim.*gate)(op_data);
+           })
+        .show_rate("OpQubits", num_qubits * num_samples);
+}
+
+BENCHMARK(FrameSimulator_feedback_CX_100Kqubits_1Ksamples) {
+    bench_feedback(&FrameSimulator::ZCX, true).goal_millis(3);
+}
+
+BENCHMARK(FrameSimulator_feedback_CY_100Kqubits_1Ksamples) {
+    bench_feedback(&FrameSimulator::ZCY, true).goal_millis(4);
+}
+
+BENCHMARK(FrameSimulator_feedback_CZ_100Kqubits_1Ksamples) {
+    bench_feedback(&FrameSimulator::ZCZ, false).goal_millis(3);
+}
+
+BENCHMARK(FrameSimulator_depolarize1_10Kqubits_1Ksamples_per10) {
+    size_t num_qubits = 10 * 1000;
+    size_t num_samples = 1000;
+    double probability = 0.1;
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    FrameSimulator sim(num_qubits, num_samples, SIZE_MAX, rng);
+
+    std::vector<GateTarget> targets;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        targets.push_back({k});
+    }
+    OperationData op_data{{&probability}, targets};
+    benchmark_go([&]() {
+        sim.DEPOLARIZE1(op_data);
+    })
+        .goal_millis(7)
+        .show_rate("OpQubits", targets.size() * num_samples);
+}
+
+BENCHMARK(FrameSimulator_pauli_channel_1_100Kqubits_1Ksamples_per1000) {
+    size_t num_qubits = 100 * 1000;
+    size_t num_samples = 1000;
+    std::vector<double> probabilities{0.0005, 0.0002, 0.0003};
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    FrameSimulator sim(num_qubits, num_samples, SIZE_MAX, rng);
+
+    std::vector<GateTarget> targets;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        targets.push_back({k});
+    }
+    OperationData op_data{probabilities, targets};
+    benchmark_go([&]() {
+        sim.PAULI_CHANNEL_1(op_data);
+    })
+        .goal_millis(4)
+        .show_rate("OpQubits", targets.size() * num_samples);
+}
+
+BENCHMARK(FrameSimulator_pauli_channel_2_100Kqubits_1Ksamples_per1000) {
+    size_t num_qubits = 100 * 1000;
+    size_t num_samples = 1000;
+    std::vector<double> probabilities(15, 0.001 / 15);
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    FrameSimulator sim(num_qubits, num_samples, SIZE_MAX, rng);
+
+    std::vector<GateTarget> targets;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        targets.push_back({k});
+    }
+    OperationData op_data{probabilities, targets};
+    benchmark_go([&]() {
+        sim.PAULI_CHANNEL_2(op_data);
+    })
+        .goal_micros(3500)
+        .show_rate("OpQubits", targets.size() * num_samples);
+}
+
+BENCHMARK(FrameSimulator_MPP_weight10_10Kqubits_1Ksamples) {
+    size_t num_qubits = 10 * 1000;
+    size_t num_samples = 1000;
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    FrameSimulator sim(num_qubits, num_samples, SIZE_MAX, rng);
+
+    std::vector<GateTarget> targets;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        if (k % 10) {
+            targets.push_back(GateTarget::combiner());
+        }
+        targets.push_back(k % 3 == 0 ? GateTarget::x(k) : k % 3 == 1 ? GateTarget::z(k) : GateTarget::y(k));
+    }
+    OperationData op_data{{}, targets};
+
+    benchmark_go([&]() {
+        sim.m_record.clear();
+        sim.MPP(op_data);
+    })
+        .goal_micros(500)
+        .show_rate("OpQubits", num_qubits * num_samples);
+}
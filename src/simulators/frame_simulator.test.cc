@@ -664,6 +664,40 @@ TEST(FrameSimulator, classical_can_control_quantum) {
         expected);
 }
 
+TEST(FrameSimulator, classical_control_mixed_with_quantum_pairs) {
+    simd_bits ref(128);
+    simd_bits expected(5);
+    expected.clear();
+    expected[0] = true;
+    expected[1] = true;
+    expected[2] = true;
+    expected[3] = true;
+    ASSERT_EQ(
+        FrameSimulator::sample(
+            Circuit(R"circuit(
+        X_ERROR(1) 0 2
+        M !0
+        CX 2 3 rec[-1] 1 0 4
+        M 1 3 4
+    )circuit"),
+            ref,
+            1,
+            SHARED_TEST_RNG())[0],
+        expected);
+    ASSERT_EQ(
+        FrameSimulator::sample(
+            Circuit(R"circuit(
+        X_ERROR(1) 0 2
+        M !0
+        XCZ 3 2 1 rec[-1] 4 0
+        M 1 3 4
+    )circuit"),
+            ref,
+            1,
+            SHARED_TEST_RNG())[0],
+        expected);
+}
+
 TEST(FrameSimulator, classical_controls) {
     simd_bits ref(128);
     simd_bits expected(5);
@@ -1317,6 +1351,29 @@ TEST(FrameSimulator, measure_pauli_product_4body) {
     }
 }
 
+TEST(FrameSimulator, measure_pauli_product_noisy_and_overlapping) {
+    auto r = FrameSimulator::sample_flipped_measurements(
+        Circuit(R"CIRCUIT(
+        H 0
+        CNOT 0 1
+        MPP X0*X1 Z0*Z1 Y0*Y1
+        MPP(1) X0*X1 Z0*Z1 Y0*Y1
+        X_ERROR(1) 0
+        MPP Z0*Z1 X0*X1 Y0*Y1
+        Z_ERROR(1) 1
+        MPP Z0*Z1 X0*X1 Y0*Y1
+    )CIRCUIT"),
+        100,
+        SHARED_TEST_RNG());
+    for (size_t k = 0; k < 100; k++) {
+        std::vector<bool> actual;
+        for (size_t m = 0; m < 12; m++) {
+            actual.push_back(r[m][k]);
+        }
+        ASSERT_EQ(actual, (std::vector<bool>{0, 0, 0, 1, 1, 1, 1, 0, 1, 1, 1, 0}));
+    }
+}
+
 TEST(FrameSimulator, non_deterministic_pauli_product_detectors) {
     auto n = FrameSimulator::sample_flipped_measurements(
                  Circuit(R"CIRCUIT(
@@ -1348,3 +1405,74 @@ TEST(FrameSimulator, non_deterministic_pauli_product_detectors) {
             .popcnt();
     ASSERT_TRUE(400 < n && n < 600);
 }
+
+static std::vector<size_t> pauli_channel_2_term_counts(
+    const std::vector<double> &probabilities, size_t num_shots, std::mt19937_64 &rng) {
+    FrameSimulator sim(2, num_shots, SIZE_MAX, rng);
+    sim.x_table.clear();
+    sim.z_table.clear();
+    std::vector<double> args = probabilities;
+    std::vector<GateTarget> targets{GateTarget{0}, GateTarget{1}};
+    sim.PAULI_CHANNEL_2({args, targets});
+
+    std::vector<size_t> counts(16, 0);
+    for (size_t s = 0; s < num_shots; s++) {
+        size_t term = 0;
+        for (size_t q = 0; q < 2; q++) {
+            bool x = sim.x_table[q][s];
+            bool z = sim.z_table[q][s];
+            term <<= 2;
+            term |= x && !z ? 1 : x && z ? 2 : !x && z ? 3 : 0;
+        }
+        counts[term]++;
+    }
+    return counts;
+}
+
+TEST(FrameSimulator, pauli_channel_term_frequencies) {
+    size_t num_shots = 100000;
+    for (double scale : {0.0001, 0.01}) {
+        std::vector<double> probabilities;
+        for (size_t k = 0; k < 15; k++) {
+            probabilities.push_back(k % 4 == 2 ? 0 : scale * (k + 1));
+        }
+        auto counts = pauli_channel_2_term_counts(probabilities, num_shots, SHARED_TEST_RNG());
+        for (size_t k = 0; k < 15; k++) {
+            double expected = probabilities[k] * num_shots;
+            double tolerance = 5 * sqrt(expected) + 1;
+            ASSERT_NEAR(counts[k + 1], expected, tolerance) << "scale=" << scale << " term=" << k;
+        }
+    }
+
+    // Probabilities past 1 are clamped, like a chain of else-correlated errors.
+    auto counts =
+        pauli_channel_2_term_counts({0.5, 0, 0.7, 0.3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 10000, SHARED_TEST_RNG());
+    ASSERT_EQ(counts[0], 0);
+    ASSERT_EQ(counts[4], 0);
+    ASSERT_NEAR(counts[1], 5000, 300);
+    ASSERT_NEAR(counts[3], 5000, 300);
+}
+
+TEST(FrameSimulator, depolarize_term_frequencies) {
+    size_t num_shots = 100000;
+    for (double p : {0.003, 0.3}) {
+        FrameSimulator sim(1, num_shots, SIZE_MAX, SHARED_TEST_RNG());
+        sim.x_table.clear();
+        sim.z_table.clear();
+        std::vector<GateTarget> targets{GateTarget{0}};
+        sim.DEPOLARIZE1({{&p}, targets});
+        size_t x = 0, y = 0, z = 0;
+        for (size_t s = 0; s < num_shots; s++) {
+            bool bx = sim.x_table[0][s];
+            bool bz = sim.z_table[0][s];
+            x += bx && !bz;
+            y += bx && bz;
+            z += !bx && bz;
+        }
+        double expected = p / 3 * num_shots;
+        double tolerance = 5 * sqrt(expected);
+        ASSERT_NEAR(x, expected, tolerance) << p;
+        ASSERT_NEAR(y, expected, tolerance) << p;
+        ASSERT_NEAR(z, expected, tolerance) << p;
+    }
+}
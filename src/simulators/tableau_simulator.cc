@@ -42,21 +42,74 @@ bool TableauSimulator::is_deterministic_z(size_t target) const {
 }
 
 void TableauSimulator::MPP(const OperationData &target_data) {
-    decompose_mpp_operation(
-        target_data,
-        inv_state.num_qubits,
-        [&](const OperationData &h_xz,
-            const OperationData &h_yz,
-            const OperationData &cnot,
-            const OperationData &meas) {
-            H_XZ(h_xz);
-            H_YZ(h_yz);
-            ZCX(cnot);
-            measure_z(meas);
-            ZCX(cnot);
-            H_YZ(h_yz);
-            H_XZ(h_xz);
+    size_t num_products = 0;
+    for_each_mpp_product(target_data, [&](ConstPointerRange<GateTarget> product) {
+        measurement_record.record_result(measure_pauli_product(product));
+        num_products++;
+    });
+
+    if (!target_data.args.empty()) {
+        size_t last = measurement_record.storage.size() - 1;
+        RareErrorIterator::for_samples(target_data.args[0], num_products, rng, [&](size_t k) {
+            measurement_record.storage[last - k] = !measurement_record.storage[last - k];
         });
+    }
+}
+
+bool TableauSimulator::measure_pauli_product(ConstPointerRange<GateTarget> product) {
+    // Find the observable, at the start of time, that the measured observable corresponds to.
+    PauliString observable(inv_state.num_qubits);
+    uint8_t log_i = 0;
+    bool flipped = false;
+    for (auto t : product) {
+        auto q = t.qubit_value();
+        flipped ^= t.is_inverted_result_target();
+        bool x = t.data & TARGET_PAULI_X_BIT;
+        bool z = t.data & TARGET_PAULI_Z_BIT;
+        if (x && z) {
+            log_i += 1;  // Y = iXZ.
+        }
+        if (x) {
+            log_i += observable.ref().inplace_right_mul_returning_log_i_scalar(inv_state.xs[q]);
+        }
+        if (z) {
+            log_i += observable.ref().inplace_right_mul_returning_log_i_scalar(inv_state.zs[q]);
+        }
+    }
+    assert((log_i & 1) == 0);
+
+    // The start of time state is |0..0>, so observables without X terms have a known value.
+    if (!observable.xs.not_zero()) {
+        return observable.sign ^ ((log_i & 2) != 0) ^ flipped;
+    }
+
+    // The result is random. Rotate the observable onto one qubit, collapse it, and rotate back.
+    std::vector<GateTarget> h_xz;
+    std::vector<GateTarget> h_yz;
+    std::vector<GateTarget> cnot;
+    GateTarget center{product[0].qubit_value()};
+    for (auto t : product) {
+        GateTarget q{t.qubit_value()};
+        if (t.data & TARGET_PAULI_X_BIT) {
+            (t.data & TARGET_PAULI_Z_BIT ? h_yz : h_xz).push_back(q);
+        }
+        if (q != center) {
+            cnot.push_back(q);
+            cnot.push_back(center);
+        }
+    }
+    H_XZ({{}, h_xz});
+    H_YZ({{}, h_yz});
+    ZCX({{}, cnot});
+    {
+        TableauTransposedRaii temp_transposed(inv_state);
+        collapse_qubit_z(center.data, temp_transposed);
+    }
+    bool result = inv_state.zs.signs[center.data] ^ flipped;
+    ZCX({{}, cnot});
+    H_YZ({{}, h_yz});
+    H_XZ({{}, h_xz});
+    return result;
 }
 
 void TableauSimulator::measure_x(const OperationData &target_data) {
@@ -671,7 +724,7 @@ void TableauSimulator::sample_stream(FILE *in, FILE *out, SampleFormat format, b
         sim.ensure_large_enough_for_qubits(unprocessed.count_qubits());
 
         unprocessed.for_each_operation([&](const Operation &op) {
-            (sim.*op.gate->tableau_simulator_function)(op.target_data);
+            sim.do_gate(op);
             sim.measurement_record.write_unwritten_results_to(*writer);
             if (interactive && (op.gate->flags & ARG_COUNT_SYGIL_ANY)) {
                 putc('\n', out);
@@ -866,7 +919,7 @@ Circuit aliased_noiseless_subset(const Circuit &circuit) {
 void TableauSimulator::expand_do_circuit(const Circuit &circuit) {
     ensure_large_enough_for_qubits(circuit.count_qubits());
     circuit.for_each_operation([&](const Operation &op) {
-        ((*this).*op.gate->tableau_simulator_function)(op.target_data);
+        do_gate(op);
     });
 }
 
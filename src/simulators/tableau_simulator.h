@@ -26,6 +26,7 @@
 
 #include "../circuit/circuit.h"
 #include "../io/measure_record.h"
+#include "../profiling.h"
 #include "../stabilizers/tableau.h"
 #include "../stabilizers/tableau_transposed_raii.h"
 #include "vector_simulator.h"
@@ -68,6 +69,20 @@ struct TableauSimulator {
     /// Finds a state vector satisfying the current stabilizer generators, and returns a vector simulator in that state.
     VectorSimulator to_vector_sim() const;
 
+    /// Applies an operation to the simulator state.
+    inline void do_gate(const Operation &op) {
+        profiled(
+            GLOBAL_PROFILER.gates[PROFILE_TABLEAU_SIMULATOR][op.gate->id],
+            [&]() {
+                // Each targeted qubit has an X row and a Z row in each half of the inverse tableau.
+                return op.target_data.targets.size() * 4 * sizeof(simd_word) *
+                       simd_bits::min_bits_to_num_simd_words(inv_state.num_qubits);
+            },
+            [&]() {
+                (this->*op.gate->tableau_simulator_function)(op.target_data);
+            });
+    }
+
     /// Returns a state vector satisfying the current stabilizer generators.
     std::vector<std::complex<float>> to_state_vector() const;
 
@@ -186,6 +201,12 @@ struct TableauSimulator {
     void CORRELATED_ERROR(const OperationData &target_data);
     void ELSE_CORRELATED_ERROR(const OperationData &target_data);
     void MPP(const OperationData &target_data);
+    /// Measures a Pauli product observable, collapsing the state, and returns the result without recording it.
+    ///
+    /// Args:
+    ///     product: The Pauli-flagged targets making up the observable, with no combiners. Each target's inversion
+    ///         flag flips the result.
+    bool measure_pauli_product(ConstPointerRange<GateTarget> product);
 
     /// Returns the single-qubit stabilizer of a target or, if it is entangled, the identity operation.
     PauliString peek_bloch(uint32_t target) const;
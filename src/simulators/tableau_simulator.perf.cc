@@ -35,3 +35,27 @@ BENCHMARK(TableauSimulator_CX_10Kqubits) {
         .goal_millis(5)
         .show_rate("OpQubits", targets.size());
 }
+
+BENCHMARK(TableauSimulator_MPP_weight10_1Kqubits) {
+    size_t num_qubits = 1000;
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    TableauSimulator sim(rng, num_qubits);
+
+    std::vector<GateTarget> targets;
+    for (uint32_t k = 0; k < (uint32_t)num_qubits; k++) {
+        if (k % 10) {
+            targets.push_back(GateTarget::combiner());
+        }
+        targets.push_back(k % 3 == 0 ? GateTarget::x(k) : k % 3 == 1 ? GateTarget::z(k) : GateTarget::y(k));
+    }
+    OperationData op_data{{}, targets};
+
+    // After the first round, every product has a known value.
+    sim.MPP(op_data);
+    benchmark_go([&]() {
+        sim.measurement_record.storage.clear();
+        sim.MPP(op_data);
+    })
+        .goal_micros(80)
+        .show_rate("OpQubits", num_qubits);
+}
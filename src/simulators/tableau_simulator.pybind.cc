@@ -17,6 +17,7 @@
 #include "../py/base.pybind.h"
 #include "../simulators/tableau_simulator.h"
 #include "../stabilizers/pauli_string.pybind.h"
+#include "../stabilizers/pauli_string_batch.h"
 #include "../stabilizers/tableau.h"
 
 using namespace stim_internal;
@@ -66,6 +67,26 @@ TempViewableData args_to_target_pairs(TableauSimulator &self, const pybind11::ar
     return result;
 }
 
+typedef pybind11::array_t<uint32_t, pybind11::array::c_style | pybind11::array::forcecast> numpy_targets;
+
+TempViewableData numpy_to_targets(TableauSimulator &self, const numpy_targets &targets) {
+    if (targets.ndim() != 1) {
+        throw std::invalid_argument("A numpy array of targets must be one dimensional.");
+    }
+    std::vector<GateTarget> arguments;
+    arguments.reserve(targets.size());
+    uint32_t max_q = 0;
+    const uint32_t *data = targets.data();
+    for (ssize_t k = 0; k < targets.size(); k++) {
+        max_q = std::max(max_q, data[k] & TARGET_VALUE_MASK);
+        arguments.push_back(GateTarget{data[k]});
+    }
+    if (!arguments.empty()) {
+        self.ensure_large_enough_for_qubits(max_q + 1);
+    }
+    return TempViewableData(arguments);
+}
+
 void pybind_tableau_simulator(pybind11::module &m) {
     auto &&c = pybind11::class_<TableauSimulator>(
         m,
@@ -710,6 +731,46 @@ void pybind_tableau_simulator(pybind11::module &m) {
         )DOC")
             .data());
 
+    c.def(
+        "peek_bloch_many",
+        [](TableauSimulator &self, const numpy_targets &targets) {
+            auto converted_args = numpy_to_targets(self, targets);
+            PauliStringBatch result(converted_args.targets.size(), 1);
+            for (size_t k = 0; k < converted_args.targets.size(); k++) {
+                result[k] = self.peek_bloch(converted_args.targets[k].data);
+            }
+            return result;
+        },
+        pybind11::arg("targets"),
+        clean_doc_string(u8R"DOC(
+            Returns the current bloch vectors of many qubits, as a batch of single qubit Pauli strings.
+
+            Equivalent to calling `peek_bloch` on each target, but done in one call. This is a non-physical operation.
+            It reports information about the qubits without disturbing them.
+
+            Args:
+                targets: A 1d array of the qubits to peek at, with dtype `numpy.uint32`.
+
+            Returns:
+                A stim.PauliStringBatch where the k'th entry is what `peek_bloch(targets[k])` would return.
+
+            Examples:
+                >>> import stim
+                >>> import numpy as np
+                >>> s = stim.TableauSimulator()
+                >>> s.x(1)
+                >>> s.h(2)
+                >>> s.h(3)
+                >>> s.cnot(3, 4)
+                >>> print(s.peek_bloch_many(np.arange(5, dtype=np.uint32)))
+                +Z
+                -Z
+                +X
+                +_
+                +_
+        )DOC")
+            .data());
+
     c.def(
         "measure",
         [](TableauSimulator &self, uint32_t target) {
@@ -737,20 +798,89 @@ void pybind_tableau_simulator(pybind11::module &m) {
 
     c.def(
         "measure_many",
-        [](TableauSimulator &self, pybind11::args args) {
+        [](TableauSimulator &self, pybind11::args args) -> pybind11::object {
+            if (pybind11::len(args) == 1 && pybind11::isinstance<pybind11::array>(args[0])) {
+                auto converted_args = numpy_to_targets(self, pybind11::cast<numpy_targets>(args[0]));
+                size_t n = converted_args.targets.size();
+                self.measure_z(converted_args);
+                pybind11::array_t<bool> result((ssize_t)n);
+                bool *out = result.mutable_data();
+                const auto &storage = self.measurement_record.storage;
+                for (size_t k = 0; k < n; k++) {
+                    out[k] = storage[storage.size() - n + k];
+                }
+                return std::move(result);
+            }
             auto converted_args = args_to_targets(self, args);
             self.measure_z(converted_args);
             auto e = self.measurement_record.storage.end();
-            return std::vector<bool>(e - converted_args.targets.size(), e);
+            return pybind11::cast(std::vector<bool>(e - converted_args.targets.size(), e));
         },
         clean_doc_string(u8R"DOC(
             Measures multiple qubits.
 
             Args:
-                *targets: The indices of the qubits to measure.
+                *targets: The indices of the qubits to measure. Alternatively, a single 1d numpy array of qubit
+                    indices (with dtype `numpy.uint32`), which is converted in bulk instead of one index at a time.
 
             Returns:
-                The measurement results as a list of bools.
+                The measurement results as a list of bools or, when the targets were given as a numpy array, as a
+                `numpy.ndarray[bool]`.
+
+            Examples:
+                >>> import stim
+                >>> import numpy as np
+                >>> s = stim.TableauSimulator()
+                >>> s.x(1, 3)
+                >>> s.measure_many(0, 1, 2, 3)
+                [False, True, False, True]
+                >>> s.measure_many(np.array([0, 1, 2, 3], dtype=np.uint32))
+                array([False,  True, False,  True])
+        )DOC")
+            .data());
+
+    c.def(
+        "do_gate_layer",
+        [](TableauSimulator &self,
+           const std::string &name,
+           const numpy_targets &targets,
+           const std::vector<double> &args) {
+            if (targets.ndim() != 1) {
+                throw std::invalid_argument("A numpy array of targets must be one dimensional.");
+            }
+            const Gate &gate = GATE_DATA.at(name);
+            const auto *begin = reinterpret_cast<const GateTarget *>(targets.data());
+            Circuit layer;
+            layer.append_operation(gate, {begin, begin + targets.size()}, args);
+            // The global interpreter lock stays held: releasing it would let another python thread use (or
+            // reallocate) this simulator while the layer is being applied.
+            self.expand_do_circuit(layer);
+        },
+        pybind11::arg("name"),
+        pybind11::arg("targets"),
+        pybind11::arg("args") = std::vector<double>{},
+        clean_doc_string(u8R"DOC(
+            Applies a gate to many targets at once.
+
+            Equivalent to `s.do(stim.Circuit(...))` with a single operation, but the targets are read directly out
+            of a numpy array instead of being converted one at a time.
+
+            Args:
+                name: The name of the gate to apply (e.g. "H" or "CNOT" or "X_ERROR" or "M").
+                targets: A 1d array of encoded gate targets, with dtype `numpy.uint32`. Plain qubit indices
+                    work, as do the values returned by methods such as `stim.target_inv`. Gates that act on
+                    pairs of qubits take their targets in consecutive pairs.
+                args: The gate's parens arguments (e.g. the probability of an X_ERROR). Defaults to no arguments.
+
+            Examples:
+                >>> import stim
+                >>> import numpy as np
+                >>> s = stim.TableauSimulator()
+                >>> s.do_gate_layer("H", np.arange(3, dtype=np.uint32))
+                >>> s.do_gate_layer("CNOT", np.array([0, 3, 1, 4, 2, 5], dtype=np.uint32))
+                >>> m = s.measure_many(np.arange(6, dtype=np.uint32))
+                >>> np.array_equal(m[:3], m[3:])
+                True
         )DOC")
             .data());
 
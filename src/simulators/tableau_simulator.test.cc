@@ -1548,6 +1548,32 @@ TEST(TableauSimulator, measure_pauli_product_4body) {
     }
 }
 
+TEST(TableauSimulator, measure_pauli_product_overlapping_and_noisy) {
+    TableauSimulator t(SHARED_TEST_RNG());
+    t.expand_do_circuit(R"CIRCUIT(
+        H 0
+        CNOT 0 1
+        MPP X0*X1 Z0*Z1 Y0*Y1 !Z0*Z1
+        MPP(1) X0*X1 Z0*Z1 Y0*Y1
+        MPP X0*X1 Z0*Z1 Y0*Y1
+    )CIRCUIT");
+    ASSERT_EQ(
+        t.measurement_record.storage,
+        (std::vector<bool>{false, false, true, true, true, true, false, false, false, true}));
+}
+
+TEST(TableauSimulator, measure_pauli_product_sign_bias) {
+    for (int8_t bias : {-1, +1}) {
+        std::mt19937_64 rng(0);
+        TableauSimulator t(rng, 3, bias);
+        t.expand_do_circuit(R"CIRCUIT(
+            MPP X0*Y1*Z2 !X0*Y1*Z2 X0*Y1*Z2
+        )CIRCUIT");
+        bool b = bias < 0;
+        ASSERT_EQ(t.measurement_record.storage, (std::vector<bool>{b, !b, b}));
+    }
+}
+
 TEST(TableauSimulator, measure_pauli_product_epr) {
     for (size_t k = 0; k < 10; k++) {
         TableauSimulator t(SHARED_TEST_RNG());
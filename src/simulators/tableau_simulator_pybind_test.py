@@ -11,6 +11,8 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+import threading
+
 import pytest
 import stim
 import numpy as np
@@ -337,3 +339,71 @@ def test_to_state_vector():
     assert v[1, 0, 0] != 0
     assert v[0, 1, 0] == 0
     assert v[0, 0, 1] == 0
+
+
+def test_measure_many_numpy():
+    s = stim.TableauSimulator()
+    s.x(1, 3)
+    result = s.measure_many(np.array([0, 1, 2, 3, 5], dtype=np.uint32))
+    assert isinstance(result, np.ndarray)
+    assert result.dtype == np.bool_
+    np.testing.assert_array_equal(result, [False, True, False, True, False])
+    assert s.current_measurement_record() == [False, True, False, True, False]
+    assert len(s.current_inverse_tableau()) == 6
+    assert s.measure_many(np.array([], dtype=np.uint32)).shape == (0,)
+    assert s.measure_many(0, 1) == [False, True]
+    with pytest.raises(ValueError, match="one dimensional"):
+        s.measure_many(np.zeros(shape=(2, 2), dtype=np.uint32))
+
+
+def test_do_gate_layer():
+    s = stim.TableauSimulator()
+    s.do_gate_layer("H", np.arange(100, dtype=np.uint32))
+    s.do_gate_layer("CNOT", np.array([k for q in range(100) for k in [q, q + 100]], dtype=np.uint32))
+    m = s.measure_many(np.arange(200, dtype=np.uint32))
+    np.testing.assert_array_equal(m[:100], m[100:])
+
+    s = stim.TableauSimulator()
+    s.do_gate_layer("X_ERROR", np.array([0, 1], dtype=np.uint32), [1])
+    s.do_gate_layer("M", np.array([0, stim.target_inv(1)], dtype=np.uint32))
+    assert s.current_measurement_record() == [True, False]
+
+    with pytest.raises(ValueError, match="even number"):
+        s.do_gate_layer("CNOT", np.array([0, 1, 2], dtype=np.uint32))
+    with pytest.raises(ValueError):
+        s.do_gate_layer("X_ERROR", np.array([0], dtype=np.uint32))
+
+
+def test_do_gate_layer_threads_while_profiling():
+    def work():
+        s = stim.TableauSimulator()
+        for _ in range(100):
+            s.do_gate_layer("H", np.arange(50, dtype=np.uint32))
+
+    stim.clear_profile()
+    stim.set_profiling_enabled(True)
+    try:
+        threads = [threading.Thread(target=work) for _ in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+    finally:
+        stim.set_profiling_enabled(False)
+    entries = {(e['section'], e['name']): e for e in stim.get_profile()}
+    stim.clear_profile()
+    assert entries[('tableau_simulator', 'H')]['count'] == 400
+
+
+def test_peek_bloch_many():
+    s = stim.TableauSimulator()
+    s.x(1)
+    s.h(2)
+    s.h(3)
+    s.cnot(3, 4)
+    s.h_yz(5)
+    targets = np.array([0, 1, 2, 3, 4, 5, 7], dtype=np.uint32)
+    result = s.peek_bloch_many(targets)
+    assert isinstance(result, stim.PauliStringBatch)
+    assert [result[k] for k in range(len(result))] == [s.peek_bloch(int(q)) for q in targets]
+    assert result == stim.PauliStringBatch(["+Z", "-Z", "+X", "_", "_", "+Y", "+Z"])
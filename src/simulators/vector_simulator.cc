@@ -14,7 +14,10 @@
 
 #include "vector_simulator.h"
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
+#include <thread>
 
 #include "../circuit/gate_data.h"
 #include "../simd/simd_util.h"
@@ -22,9 +25,208 @@
 
 using namespace stim_internal;
 
+/// Each thread used for an update gets at least this many amplitudes, so smaller states are updated on the calling
+/// thread. Threads are started per update, so this is set high enough that their start-up cost is small next to the
+/// work they do.
+constexpr size_t MIN_AMPLITUDES_PER_THREAD = size_t{1} << 18;
+
 VectorSimulator::VectorSimulator(size_t num_qubits) {
     state.resize(size_t{1} << num_qubits, 0.0f);
     state[0] = 1;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // WebAssembly builds without pthreads support can't start threads.
+    num_threads = 1;
+#else
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+template <typename BODY>
+void VectorSimulator::for_each_range(size_t n, BODY body) const {
+    size_t used_threads = std::min(num_threads, state.size() / MIN_AMPLITUDES_PER_THREAD);
+    if (used_threads <= 1) {
+        body(0, n);
+        return;
+    }
+    size_t chunk = (n + used_threads - 1) / used_threads;
+    std::vector<std::thread> threads;
+    for (size_t start = chunk; start < n; start += chunk) {
+        size_t end = std::min(n, start + chunk);
+        threads.emplace_back([=]() {
+            body(start, end);
+        });
+    }
+    body(0, std::min(n, chunk));
+    for (auto &t : threads) {
+        t.join();
+    }
+}
+
+/// Inserts a zero bit into an integer at the given bit position.
+inline size_t insert_zero_bit(size_t value, size_t bit) {
+    size_t low_mask = (size_t{1} << bit) - 1;
+    return ((value & ~low_mask) << 1) | (value & low_mask);
+}
+
+/// Iterates over runs of consecutive amplitude indices whose bit at the given position is 0, covering those with pair
+/// indices in [start, end). Calls body(first_index, run_length) for each run.
+///
+/// `segment` must be a power of two no larger than 1 << bit. Runs never cross a multiple of it, so index bits at or
+/// above its position are constant within a run.
+template <typename FUNC>
+inline void for_each_run_with_zero_bit(size_t bit, size_t segment, size_t start, size_t end, FUNC body) {
+    size_t p = start;
+    while (p < end) {
+        size_t run = std::min(segment - (p & (segment - 1)), end - p);
+        body(insert_zero_bit(p, bit), run);
+        p += run;
+    }
+}
+
+/// Same as `for_each_run_with_zero_bit`, but for amplitudes whose bits at two positions (with bit1 < bit2) are 0.
+template <typename FUNC>
+inline void for_each_run_with_zero_bits(size_t bit1, size_t bit2, size_t start, size_t end, FUNC body) {
+    size_t segment = size_t{1} << bit1;
+    size_t p = start;
+    while (p < end) {
+        size_t run = std::min(segment - (p & (segment - 1)), end - p);
+        body(insert_zero_bit(insert_zero_bit(p, bit1), bit2), run);
+        p += run;
+    }
+}
+
+/// Multiplies each amplitude pair (a[k], b[k]) of two disjoint runs of n amplitudes by a 2x2 matrix.
+///
+/// The matrix is given as the real and imaginary parts of its entries, in row major order. Complex arithmetic is
+/// written out over floats, to avoid std::complex's slow handling of infinities and NaNs and so that the loop
+/// vectorizes.
+inline void mul_runs_2x2(float *a, float *b, size_t n, const float *m) {
+    float m00r = m[0], m00i = m[1], m01r = m[2], m01i = m[3];
+    float m10r = m[4], m10i = m[5], m11r = m[6], m11i = m[7];
+    for (size_t k = 0; k < 2 * n; k += 2) {
+        float ar = a[k];
+        float ai = a[k + 1];
+        float br = b[k];
+        float bi = b[k + 1];
+        a[k] = m00r * ar - m00i * ai + m01r * br - m01i * bi;
+        a[k + 1] = m00r * ai + m00i * ar + m01r * bi + m01i * br;
+        b[k] = m10r * ar - m10i * ai + m11r * br - m11i * bi;
+        b[k + 1] = m10r * ai + m10i * ar + m11r * bi + m11i * br;
+    }
+}
+
+/// Same as `mul_runs_2x2`, but for the two halves of each of `num_blocks` consecutive blocks of 2 * S amplitudes.
+///
+/// Used for the lowest qubits, whose runs are too short to vectorize. With S fixed, the loop over blocks vectorizes.
+template <size_t S>
+inline void mul_blocks_2x2(float *data, size_t num_blocks, const float *m) {
+    float m00r = m[0], m00i = m[1], m01r = m[2], m01i = m[3];
+    float m10r = m[4], m10i = m[5], m11r = m[6], m11i = m[7];
+    for (size_t blk = 0; blk < num_blocks; blk++) {
+        float *a = data + 4 * S * blk;
+        float *b = a + 2 * S;
+        for (size_t k = 0; k < 2 * S; k += 2) {
+            float ar = a[k];
+            float ai = a[k + 1];
+            float br = b[k];
+            float bi = b[k + 1];
+            a[k] = m00r * ar - m00i * ai + m01r * br - m01i * bi;
+            a[k + 1] = m00r * ai + m00i * ar + m01r * bi + m01i * br;
+            b[k] = m10r * ar - m10i * ai + m11r * br - m11i * bi;
+            b[k + 1] = m10r * ai + m10i * ar + m11r * bi + m11i * br;
+        }
+    }
+}
+
+/// Same as `mul_runs_2x2`, but for the amplitude quadruples of four disjoint runs and a 4x4 matrix.
+inline void mul_runs_4x4(float *const *runs, size_t n, const float *m) {
+    float c[32];
+    std::copy(m, m + 32, c);
+    float *r0 = runs[0];
+    float *r1 = runs[1];
+    float *r2 = runs[2];
+    float *r3 = runs[3];
+    for (size_t k = 0; k < 2 * n; k += 2) {
+        float in[8]{r0[k], r0[k + 1], r1[k], r1[k + 1], r2[k], r2[k + 1], r3[k], r3[k + 1]};
+        float out[8];
+        for (size_t r = 0; r < 4; r++) {
+            float re = 0;
+            float im = 0;
+            for (size_t q = 0; q < 4; q++) {
+                re += c[8 * r + 2 * q] * in[2 * q] - c[8 * r + 2 * q + 1] * in[2 * q + 1];
+                im += c[8 * r + 2 * q] * in[2 * q + 1] + c[8 * r + 2 * q + 1] * in[2 * q];
+            }
+            out[2 * r] = re;
+            out[2 * r + 1] = im;
+        }
+        r0[k] = out[0];
+        r0[k + 1] = out[1];
+        r1[k] = out[2];
+        r1[k + 1] = out[3];
+        r2[k] = out[4];
+        r2[k + 1] = out[5];
+        r3[k] = out[6];
+        r3[k + 1] = out[7];
+    }
+}
+
+/// Multiplies a run of n amplitudes by a real factor.
+inline void scale_run(float *a, size_t n, float f) {
+    for (size_t k = 0; k < 2 * n; k++) {
+        a[k] *= f;
+    }
+}
+
+void VectorSimulator::apply_1q(const std::vector<std::vector<std::complex<float>>> &matrix, size_t qubit) {
+    float m[8];
+    for (size_t r = 0; r < 2; r++) {
+        for (size_t c = 0; c < 2; c++) {
+            m[4 * r + 2 * c] = matrix[r][c].real();
+            m[4 * r + 2 * c + 1] = matrix[r][c].imag();
+        }
+    }
+    float *data = reinterpret_cast<float *>(state.data());
+    size_t stride = size_t{1} << qubit;
+    if (stride <= 4) {
+        for_each_range(state.size() >> (qubit + 1), [&](size_t start, size_t end) {
+            if (stride == 1) {
+                mul_blocks_2x2<1>(data + 4 * start, end - start, m);
+            } else if (stride == 2) {
+                mul_blocks_2x2<2>(data + 8 * start, end - start, m);
+            } else {
+                mul_blocks_2x2<4>(data + 16 * start, end - start, m);
+            }
+        });
+        return;
+    }
+    for_each_range(state.size() >> 1, [&](size_t start, size_t end) {
+        for_each_run_with_zero_bit(qubit, stride, start, end, [&](size_t i, size_t n) {
+            mul_runs_2x2(data + 2 * i, data + 2 * (i | stride), n, m);
+        });
+    });
+}
+
+void VectorSimulator::apply_2q(
+    const std::vector<std::vector<std::complex<float>>> &matrix, size_t qubit1, size_t qubit2) {
+    float m[32];
+    for (size_t r = 0; r < 4; r++) {
+        for (size_t c = 0; c < 4; c++) {
+            m[8 * r + 2 * c] = matrix[r][c].real();
+            m[8 * r + 2 * c + 1] = matrix[r][c].imag();
+        }
+    }
+    float *data = reinterpret_cast<float *>(state.data());
+    size_t mask1 = size_t{1} << qubit1;
+    size_t mask2 = size_t{1} << qubit2;
+    size_t low = std::min(qubit1, qubit2);
+    size_t high = std::max(qubit1, qubit2);
+    for_each_range(state.size() >> 2, [&](size_t start, size_t end) {
+        for_each_run_with_zero_bits(low, high, start, end, [&](size_t i, size_t n) {
+            float *runs[4]{
+                data + 2 * i, data + 2 * (i | mask1), data + 2 * (i | mask2), data + 2 * (i | mask1 | mask2)};
+            mul_runs_4x4(runs, n, m);
+        });
+    });
 }
 
 std::vector<std::complex<float>> mat_vec_mul(
@@ -44,6 +246,14 @@ void VectorSimulator::apply(
     const std::vector<std::vector<std::complex<float>>> &matrix, const std::vector<size_t> &qubits) {
     size_t n = size_t{1} << qubits.size();
     assert(matrix.size() == n);
+    if (qubits.size() == 1) {
+        apply_1q(matrix, qubits[0]);
+        return;
+    }
+    if (qubits.size() == 2) {
+        apply_2q(matrix, qubits[0], qubits[1]);
+        return;
+    }
     std::vector<size_t> masks;
     for (size_t k = 0; k < n; k++) {
         size_t m = 0;
@@ -87,24 +297,90 @@ void VectorSimulator::apply(const std::string &gate, size_t qubit1, size_t qubit
     }
 }
 
-void VectorSimulator::apply(const PauliStringRef &gate, size_t qubit_offset) {
-    if (gate.sign) {
-        for (auto &e : state) {
-            e *= -1;
+/// The bit masks of a Pauli string's X and Z terms, and its phase, so that P|v> = phase * (-1)^|v & z| * |v ^ x>.
+struct PauliMasks {
+    size_t x;
+    size_t z;
+    float phase_re;
+    float phase_im;
+
+    PauliMasks(const PauliStringRef &pauli, size_t qubit_offset)
+        : x(0), z(0), phase_re(pauli.sign ? -1 : +1), phase_im(0) {
+        assert(pauli.num_qubits + qubit_offset <= 64);
+        for (size_t k = 0; k < pauli.num_qubits; k++) {
+            bool px = pauli.xs[k];
+            bool pz = pauli.zs[k];
+            x |= (size_t)px << (k + qubit_offset);
+            z |= (size_t)pz << (k + qubit_offset);
+            if (px && pz) {
+                // Y = iXZ.
+                float re = -phase_im;
+                phase_im = phase_re;
+                phase_re = re;
+            }
         }
     }
-    for (size_t k = 0; k < gate.num_qubits; k++) {
-        bool x = gate.xs[k];
-        bool z = gate.zs[k];
-        size_t q = qubit_offset + k;
-        if (x && z) {
-            apply("Y", q);
-        } else if (x) {
-            apply("X", q);
-        } else if (z) {
-            apply("Z", q);
+
+    /// The sign of the Z terms acting on the given basis state.
+    inline float z_sign(size_t v) const {
+        return (popcnt64(v & z) & 1) ? -1.0f : +1.0f;
+    }
+
+    /// The lowest qubit flipped by the X terms. Requires x != 0.
+    inline size_t lowest_x_bit() const {
+        size_t bit = 0;
+        while (!((x >> bit) & 1)) {
+            bit++;
         }
+        return bit;
+    }
+
+    /// The length of the aligned runs of basis states that `z_sign` is constant on, capped at the given power of two.
+    inline size_t z_sign_segment(size_t limit) const {
+        size_t low = z & (limit - 1);
+        return low ? low & (~low + 1) : limit;
     }
+};
+
+/// Iterates over aligned runs of `segment` (a power of two) consecutive amplitude indices, covering [start, end).
+/// Calls body(first_index, run_length) for each run.
+template <typename FUNC>
+inline void for_each_run(size_t segment, size_t start, size_t end, FUNC body) {
+    size_t i = start;
+    while (i < end) {
+        size_t run = std::min(segment - (i & (segment - 1)), end - i);
+        body(i, run);
+        i += run;
+    }
+}
+
+void VectorSimulator::apply(const PauliStringRef &gate, size_t qubit_offset) {
+    assert(size_t{1} << (gate.num_qubits + qubit_offset) <= state.size());
+    PauliMasks p(gate, qubit_offset);
+    float *data = reinterpret_cast<float *>(state.data());
+    if (p.x == 0) {
+        size_t segment = p.z_sign_segment(state.size());
+        for_each_range(state.size(), [&](size_t start, size_t end) {
+            for_each_run(segment, start, end, [&](size_t i, size_t n) {
+                scale_run(data + 2 * i, n, p.z_sign(i) * p.phase_re);
+            });
+        });
+        return;
+    }
+
+    // Swap each amplitude with its X-flipped partner, while applying the phases. X-flipping doesn't change bits below
+    // the lowest X term, so runs of amplitudes map to runs of partners.
+    size_t bit = p.lowest_x_bit();
+    size_t segment = p.z_sign_segment(size_t{1} << bit);
+    for_each_range(state.size() >> 1, [&](size_t start, size_t end) {
+        for_each_run_with_zero_bit(bit, segment, start, end, [&](size_t a, size_t n) {
+            size_t b = a ^ p.x;
+            float sa = p.z_sign(a);
+            float sb = p.z_sign(b);
+            float m[8]{0, 0, sb * p.phase_re, sb * p.phase_im, sa * p.phase_re, sa * p.phase_im, 0, 0};
+            mul_runs_2x2(data + 2 * a, data + 2 * b, n, m);
+        });
+    });
 }
 
 VectorSimulator VectorSimulator::from_stabilizers(const std::vector<PauliStringRef> stabilizers, std::mt19937_64 &rng) {
@@ -130,42 +406,50 @@ VectorSimulator VectorSimulator::from_stabilizers(const std::vector<PauliStringR
 
 float VectorSimulator::project(const PauliStringRef &observable) {
     assert(1ULL << observable.num_qubits == state.size());
-    auto basis_change = [&]() {
-        for (size_t k = 0; k < observable.num_qubits; k++) {
-            if (observable.xs[k]) {
-                if (observable.zs[k]) {
-                    apply("H_YZ", k);
-                } else {
-                    apply("H_XZ", k);
-                }
-            }
-        }
-    };
+    PauliMasks p(observable, 0);
+    float *data = reinterpret_cast<float *>(state.data());
 
-    uint64_t mask = 0;
-    for (size_t k = 0; k < observable.num_qubits; k++) {
-        if (observable.xs[k] | observable.zs[k]) {
-            mask |= 1ULL << k;
-        }
+    // Apply the projector (1 + P)/2 directly, instead of changing basis so that P is diagonal.
+    if (p.x == 0) {
+        size_t segment = p.z_sign_segment(state.size());
+        for_each_range(state.size(), [&](size_t start, size_t end) {
+            for_each_run(segment, start, end, [&](size_t i, size_t n) {
+                if (p.z_sign(i) * p.phase_re < 0) {
+                    std::fill(data + 2 * i, data + 2 * (i + n), 0.0f);
+                }
+            });
+        });
+    } else {
+        size_t bit = p.lowest_x_bit();
+        size_t segment = p.z_sign_segment(size_t{1} << bit);
+        for_each_range(state.size() >> 1, [&](size_t start, size_t end) {
+            for_each_run_with_zero_bit(bit, segment, start, end, [&](size_t a, size_t n) {
+                size_t b = a ^ p.x;
+                float sa = 0.5f * p.z_sign(a);
+                float sb = 0.5f * p.z_sign(b);
+                float m[8]{0.5f, 0, sb * p.phase_re, sb * p.phase_im, sa * p.phase_re, sa * p.phase_im, 0.5f, 0};
+                mul_runs_2x2(data + 2 * a, data + 2 * b, n, m);
+            });
+        });
     }
 
-    basis_change();
-    float mag2 = 0;
-    for (size_t i = 0; i < state.size(); i++) {
-        bool reject = observable.sign;
-        reject ^= (popcnt64(i & mask) & 1) != 0;
-        if (reject) {
-            state[i] = 0;
-        } else {
-            mag2 += state[i].real() * state[i].real() + state[i].imag() * state[i].imag();
+    // Renormalize.
+    double total = 0;
+    std::mutex total_mutex;
+    for_each_range(state.size(), [&](size_t start, size_t end) {
+        double partial = 0;
+        for (size_t i = start; i < end; i++) {
+            partial += (double)data[2 * i] * data[2 * i] + (double)data[2 * i + 1] * data[2 * i + 1];
         }
-    }
+        std::lock_guard<std::mutex> lock(total_mutex);
+        total += partial;
+    });
+    float mag2 = (float)total;
     assert(mag2 > 1e-8);
-    auto w = sqrtf(mag2);
-    for (size_t i = 0; i < state.size(); i++) {
-        state[i] /= w;
-    }
-    basis_change();
+    float scale = 1.0f / sqrtf(mag2);
+    for_each_range(state.size(), [&](size_t start, size_t end) {
+        scale_run(data + 2 * start, end - start, scale);
+    });
     return mag2;
 }
 
@@ -28,9 +28,12 @@ namespace stim_internal {
 
 /// A state vector quantum circuit simulator.
 ///
-/// Not intended to be particularly performant. Mostly used as a reference when testing.
+/// Mostly used as a reference when testing. One and two qubit gates, Pauli gates, and Pauli projections have
+/// specialized kernels, and large state vectors are updated using several threads.
 struct VectorSimulator {
     std::vector<std::complex<float>> state;
+    /// The maximum number of threads to use when updating the state vector. Threads are only started for large states.
+    size_t num_threads;
 
     /// Creates a state vector for the given number of qubits, initialized to the zero state.
     explicit VectorSimulator(size_t num_qubits);
@@ -42,6 +45,8 @@ struct VectorSimulator {
     static VectorSimulator from_stabilizers(const std::vector<PauliStringRef> stabilizers, std::mt19937_64 &rng);
 
     /// Applies a unitary operation to the given qubits, updating the state vector.
+    ///
+    /// The matrix is indexed so that bit k of a row/column index corresponds to the k'th given qubit.
     void apply(const std::vector<std::vector<std::complex<float>>> &matrix, const std::vector<size_t> &qubits);
 
     /// Helper method for applying named single qubit gates.
@@ -63,6 +68,13 @@ struct VectorSimulator {
 
     /// A description of the state vector's state.
     std::string str() const;
+
+   private:
+    void apply_1q(const std::vector<std::vector<std::complex<float>>> &matrix, size_t qubit);
+    void apply_2q(const std::vector<std::vector<std::complex<float>>> &matrix, size_t qubit1, size_t qubit2);
+    /// Calls body(start, end) on disjoint ranges covering [0, n), in parallel when worthwhile.
+    template <typename BODY>
+    void for_each_range(size_t n, BODY body) const;
 };
 
 /// Writes a description of the state vector's state to an output stream.
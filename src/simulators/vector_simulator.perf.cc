@@ -0,0 +1,79 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "vector_simulator.h"
+
+#include "../benchmark_util.h"
+#include "../circuit/gate_data.h"
+
+using namespace stim_internal;
+
+BENCHMARK(VectorSimulator_hadamard_20qubits) {
+    VectorSimulator sim(20);
+    const auto &u = GATE_DATA.at("H").unitary();
+    benchmark_go([&]() {
+        for (size_t q = 0; q < 20; q++) {
+            sim.apply(u, {q});
+        }
+    })
+        .goal_millis(40)
+        .show_rate("OpQubits", 20);
+}
+
+BENCHMARK(VectorSimulator_cnot_20qubits) {
+    VectorSimulator sim(20);
+    const auto &u = GATE_DATA.at("CNOT").unitary();
+    benchmark_go([&]() {
+        for (size_t q = 0; q < 20; q++) {
+            sim.apply(u, {q, (q + 1) % 20});
+        }
+    })
+        .goal_millis(75)
+        .show_rate("OpQubits", 20);
+}
+
+BENCHMARK(VectorSimulator_project_20qubits) {
+    VectorSimulator sim(20);
+    sim.apply("H_XZ", 0);
+    auto observable = PauliString::from_str("XYZXYZXYZXYZXYZXYZXY");
+    benchmark_go([&]() {
+        sim.project(observable);
+    })
+        .goal_millis(5)
+        .show_rate("Projections", 1);
+}
+
+BENCHMARK(VectorSimulator_from_stabilizers_16qubits) {
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    std::vector<PauliString> stabilizers;
+    for (size_t q = 0; q < 16; q++) {
+        PauliString p(16);
+        p.zs[q] = true;
+        p.xs[(q + 1) % 16] = true;
+        stabilizers.push_back(p);
+    }
+    std::vector<PauliStringRef> refs;
+    for (const auto &p : stabilizers) {
+        refs.push_back(p.ref());
+    }
+    size_t total = 0;
+    benchmark_go([&]() {
+        total += VectorSimulator::from_stabilizers(refs, rng).state.size();
+    })
+        .goal_millis(5)
+        .show_rate("States", 1);
+    if (total == 0) {
+        std::cout << "data dependence";
+    }
+}
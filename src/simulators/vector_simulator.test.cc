@@ -279,3 +279,94 @@ TEST(VectorSim, from_stabilizers) {
     ref.state = {0, sqrtf(0.5), 0, 0, 0, 0, {0, -sqrtf(0.5)}, 0};
     ASSERT_TRUE(sim.approximate_equals(ref, true));
 }
+
+static VectorSimulator random_state(size_t num_qubits, std::mt19937_64 &rng) {
+    VectorSimulator sim(num_qubits);
+    std::uniform_real_distribution<float> dist(-1.0, +1.0);
+    for (auto &e : sim.state) {
+        e = {dist(rng), dist(rng)};
+    }
+    sim.project(PauliString(num_qubits));
+    return sim;
+}
+
+/// Extends a unitary to act trivially on an additional, most significant, qubit.
+static std::vector<std::vector<std::complex<float>>> with_extra_qubit(
+    const std::vector<std::vector<std::complex<float>>> &matrix) {
+    size_t n = matrix.size();
+    std::vector<std::vector<std::complex<float>>> result(2 * n, std::vector<std::complex<float>>(2 * n, 0));
+    for (size_t r = 0; r < 2 * n; r++) {
+        for (size_t c = 0; c < 2 * n; c++) {
+            if (r / n == c / n) {
+                result[r][c] = matrix[r % n][c % n];
+            }
+        }
+    }
+    return result;
+}
+
+TEST(vector_sim, specialized_kernels_match_generic_kernel) {
+    auto &rng = SHARED_TEST_RNG();
+    for (const char *gate : {"H_XY", "SQRT_Y", "C_XYZ"}) {
+        const auto &u = GATE_DATA.at(gate).unitary();
+        for (size_t q : {0, 2, 4}) {
+            auto sim = random_state(5, rng);
+            auto ref = sim;
+            sim.apply(u, {q});
+            ref.apply(with_extra_qubit(with_extra_qubit(u)), {q, (q + 1) % 5, (q + 3) % 5});
+            ASSERT_TRUE(sim.approximate_equals(ref)) << gate << " " << q;
+        }
+    }
+    for (const char *gate : {"SQRT_XX", "ISWAP", "ZCY", "XCZ"}) {
+        const auto &u = GATE_DATA.at(gate).unitary();
+        for (auto qs : std::vector<std::pair<size_t, size_t>>{{0, 1}, {1, 0}, {4, 2}, {0, 3}}) {
+            auto sim = random_state(5, rng);
+            auto ref = sim;
+            size_t spare = 0;
+            while (spare == qs.first || spare == qs.second) {
+                spare++;
+            }
+            sim.apply(u, {qs.first, qs.second});
+            ref.apply(with_extra_qubit(u), {qs.first, qs.second, spare});
+            ASSERT_TRUE(sim.approximate_equals(ref)) << gate << " " << qs.first << " " << qs.second;
+        }
+    }
+}
+
+TEST(vector_sim, apply_pauli_matches_single_qubit_gates) {
+    auto &rng = SHARED_TEST_RNG();
+    for (size_t k = 0; k < 20; k++) {
+        auto p = PauliString::random(4, rng);
+        auto sim = random_state(6, rng);
+        auto ref = sim;
+        sim.apply(p.ref(), 1);
+        if (p.sign) {
+            ref.apply(PauliString::from_str("-").ref(), 0);
+        }
+        for (size_t q = 0; q < 4; q++) {
+            if (p.xs[q] || p.zs[q]) {
+                ref.apply(p.xs[q] ? (p.zs[q] ? "Y" : "X") : "Z", q + 1);
+            }
+        }
+        ASSERT_TRUE(sim.approximate_equals(ref)) << p;
+    }
+}
+
+TEST(vector_sim, multithreaded_matches_single_threaded) {
+    auto &rng = SHARED_TEST_RNG();
+    auto threaded = random_state(20, rng);
+    threaded.num_threads = 4;
+    auto single = threaded;
+    single.num_threads = 1;
+    for (auto *sim : {&threaded, &single}) {
+        sim->apply("H_XZ", 19);
+        sim->apply("SQRT_X", 0);
+        sim->apply("ZCX", 3, 19);
+        sim->apply("ISWAP", 18, 1);
+        sim->apply(PauliString::from_str("XYZ_X").ref(), 10);
+        sim->apply(PauliString::from_str("Z_Z").ref(), 17);
+        sim->project(PauliString::from_str("-XXXXXXXXXXXXXXXXXXXY"));
+        sim->project(PauliString::from_str("ZZ__________________"));
+    }
+    ASSERT_TRUE(threaded.approximate_equals(single));
+}
@@ -0,0 +1,230 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "zx_graph_solver.h"
+
+#include <algorithm>
+
+#include "tableau_simulator.h"
+
+using namespace stim_internal;
+
+constexpr uint32_t NO_QUBIT = UINT32_MAX;
+
+struct ZxGraphSolver {
+    std::mt19937_64 irrelevant_rng;
+    TableauSimulator sim;
+    std::vector<uint32_t> free_qubits;
+    size_t num_allocated_qubits;
+
+    // Collapsing towards False makes every non-deterministic measurement produce the postselected result.
+    ZxGraphSolver() : irrelevant_rng(0), sim(irrelevant_rng, 0, +1), free_qubits(), num_allocated_qubits(0) {
+    }
+
+    void apply(void (TableauSimulator::*gate)(const OperationData &), uint32_t q) {
+        GateTarget t{q};
+        (sim.*gate)({{}, {&t}});
+    }
+
+    void apply(void (TableauSimulator::*gate)(const OperationData &), uint32_t q1, uint32_t q2) {
+        GateTarget t[]{GateTarget{q1}, GateTarget{q2}};
+        (sim.*gate)({{}, {&t[0], &t[2]}});
+    }
+
+    uint32_t alloc_qubit() {
+        if (!free_qubits.empty()) {
+            uint32_t q = free_qubits.back();
+            free_qubits.pop_back();
+            return q;
+        }
+        uint32_t q = (uint32_t)num_allocated_qubits++;
+        if (num_allocated_qubits > sim.inv_state.num_qubits) {
+            // Grow geometrically, to avoid repeatedly copying the tableau.
+            sim.ensure_large_enough_for_qubits(std::max(num_allocated_qubits, sim.inv_state.num_qubits * 2));
+        }
+        return q;
+    }
+
+    /// Returns a qubit to the pool. The qubit must be in the |0> state.
+    void free_qubit(uint32_t q) {
+        free_qubits.push_back(q);
+    }
+
+    /// Forces the given qubits into the |0> state, then returns them to the pool.
+    ///
+    /// All the qubits are collapsed while the tableau is transposed once, instead of paying for a transpose per qubit.
+    void postselect_and_free(const std::vector<uint32_t> &qubits) {
+        TableauTransposedRaii temp_transposed(sim.inv_state);
+        for (auto q : qubits) {
+            sim.collapse_qubit_z(q, temp_transposed);
+            if (sim.inv_state.zs.signs[q]) {
+                throw std::invalid_argument("Impossible postselection. Graph contained a contradiction.");
+            }
+            free_qubit(q);
+        }
+    }
+};
+
+std::vector<PauliString> stim_internal::zx_graph_dual_stabilizers(
+    const std::vector<ZxNode> &nodes, const std::vector<std::pair<size_t, size_t>> &edges) {
+    // Drop self edges and cancel out repeated edges.
+    std::vector<std::pair<size_t, size_t>> sorted_edges;
+    for (auto e : edges) {
+        if (e.first >= nodes.size() || e.second >= nodes.size()) {
+            throw std::invalid_argument("Edge (" + std::to_string(e.first) + ", " + std::to_string(e.second) +
+                                        ") refers to a node id that's out of range.");
+        }
+        if (e.first != e.second) {
+            sorted_edges.push_back({std::min(e.first, e.second), std::max(e.first, e.second)});
+        }
+    }
+    std::sort(sorted_edges.begin(), sorted_edges.end());
+    std::vector<std::pair<size_t, size_t>> reduced_edges;
+    for (size_t k = 0; k < sorted_edges.size();) {
+        size_t run = k;
+        while (run < sorted_edges.size() && sorted_edges[run] == sorted_edges[k]) {
+            run++;
+        }
+        if ((run - k) & 1) {
+            reduced_edges.push_back(sorted_edges[k]);
+        }
+        k = run;
+    }
+
+    // Index the edges incident to each node.
+    std::vector<size_t> incident_offsets(nodes.size() + 1, 0);
+    for (const auto &e : reduced_edges) {
+        incident_offsets[e.first + 1]++;
+        incident_offsets[e.second + 1]++;
+    }
+    for (size_t n = 0; n < nodes.size(); n++) {
+        incident_offsets[n + 1] += incident_offsets[n];
+    }
+    std::vector<size_t> incident_edges(incident_offsets.back());
+    {
+        std::vector<size_t> fill(incident_offsets.begin(), incident_offsets.end() - 1);
+        for (size_t e = 0; e < reduced_edges.size(); e++) {
+            incident_edges[fill[reduced_edges[e].first]++] = e;
+            incident_edges[fill[reduced_edges[e].second]++] = e;
+        }
+    }
+    for (size_t n = 0; n < nodes.size(); n++) {
+        size_t degree = incident_offsets[n + 1] - incident_offsets[n];
+        auto kind = nodes[n].kind;
+        if ((kind == ZX_NODE_IN || kind == ZX_NODE_OUT) && degree != 1) {
+            throw std::invalid_argument(
+                "Input and output nodes must have exactly one neighbor, but node " + std::to_string(n) + " has " +
+                std::to_string(degree) + ".");
+        }
+        if (kind == ZX_NODE_H && degree != 2) {
+            throw std::invalid_argument(
+                "Hadamard nodes must have exactly two neighbors, but node " + std::to_string(n) + " has " +
+                std::to_string(degree) + ".");
+        }
+        if (kind > ZX_NODE_OUT) {
+            throw std::invalid_argument("Node " + std::to_string(n) + " has an unknown kind.");
+        }
+    }
+
+    // Interpret each edge as a cup producing an EPR pair.
+    // - The qubits of the EPR pair fly away from the center of the edge, towards their respective nodes.
+    // - The qubits are created when the first of the edge's nodes is processed.
+    ZxGraphSolver solver;
+    std::vector<uint32_t> qubit_toward_first(reduced_edges.size(), NO_QUBIT);
+    std::vector<uint32_t> qubit_toward_second(reduced_edges.size(), NO_QUBIT);
+    auto qubit_toward = [&](size_t e, size_t n) -> uint32_t {
+        if (qubit_toward_first[e] == NO_QUBIT) {
+            uint32_t a = solver.alloc_qubit();
+            uint32_t b = solver.alloc_qubit();
+            solver.apply(&TableauSimulator::H_XZ, a);
+            solver.apply(&TableauSimulator::ZCX, a, b);
+            qubit_toward_first[e] = a;
+            qubit_toward_second[e] = b;
+        }
+        return reduced_edges[e].first == n ? qubit_toward_first[e] : qubit_toward_second[e];
+    };
+
+    // Interpret each internal node as a family of post-selected parity measurements.
+    std::vector<uint32_t> incoming;
+    for (size_t n = 0; n < nodes.size(); n++) {
+        auto kind = nodes[n].kind;
+        if (kind == ZX_NODE_IN || kind == ZX_NODE_OUT) {
+            continue;  // Don't measure qubits leaving the system.
+        }
+        incoming.clear();
+        for (size_t k = incident_offsets[n]; k < incident_offsets[n + 1]; k++) {
+            incoming.push_back(qubit_toward(incident_edges[k], n));
+        }
+        if (incoming.empty()) {
+            // A lone spider is a scalar, which is zero when its angle is pi.
+            if (kind != ZX_NODE_H && (nodes[n].quarter_turns & 3) == 2) {
+                throw std::invalid_argument("Impossible postselection. Graph contained a contradiction.");
+            }
+            continue;
+        }
+
+        if (kind == ZX_NODE_X) {
+            // Surround X type node with Hadamards so it can be handled as if it were Z type.
+            for (auto q : incoming) {
+                solver.apply(&TableauSimulator::H_XZ, q);
+            }
+        } else if (kind == ZX_NODE_H) {
+            // Hadamard one input so the H node can be handled as if it were Z type.
+            solver.apply(&TableauSimulator::H_XZ, incoming[0]);
+        }
+
+        // Handle Z type node.
+        // - Postselects the ZZ observable over each pair of incoming qubits.
+        // - Postselects the (S**quarter_turns X S**-quarter_turns)XX..X observable over all incoming qubits.
+        uint32_t center = incoming[0];
+        uint8_t quarter_turns = kind == ZX_NODE_H ? 0 : nodes[n].quarter_turns & 3;
+        if (quarter_turns == 1) {
+            solver.apply(&TableauSimulator::SQRT_Z, center);
+        } else if (quarter_turns == 2) {
+            solver.apply(&TableauSimulator::Z, center);
+        } else if (quarter_turns == 3) {
+            solver.apply(&TableauSimulator::SQRT_Z_DAG, center);
+        }
+        for (size_t k = 1; k < incoming.size(); k++) {
+            solver.apply(&TableauSimulator::ZCX, center, incoming[k]);
+        }
+        solver.apply(&TableauSimulator::H_XZ, center);
+        solver.postselect_and_free(incoming);
+    }
+
+    // Find output qubits.
+    std::vector<uint32_t> ext_qubits;
+    for (auto ext_kind : {ZX_NODE_IN, ZX_NODE_OUT}) {
+        for (size_t n = 0; n < nodes.size(); n++) {
+            if (nodes[n].kind == ext_kind) {
+                ext_qubits.push_back(qubit_toward(incident_edges[incident_offsets[n]], n));
+            }
+        }
+    }
+
+    // Move the external qubits to the start, and drop the qubits of the internal edges (which are all |0> now).
+    size_t num_ext = ext_qubits.size();
+    size_t scratch = std::max(solver.num_allocated_qubits, num_ext);
+    solver.sim.ensure_large_enough_for_qubits(scratch + num_ext);
+    for (size_t k = 0; k < num_ext; k++) {
+        solver.apply(&TableauSimulator::SWAP, ext_qubits[k], (uint32_t)(scratch + k));
+    }
+    for (size_t k = 0; k < num_ext; k++) {
+        solver.apply(&TableauSimulator::SWAP, (uint32_t)k, (uint32_t)(scratch + k));
+    }
+    solver.sim.set_num_qubits(num_ext);
+
+    // Stabilizers of the simulator state are the external stabilizers of the graph.
+    return solver.sim.canonical_stabilizers();
+}
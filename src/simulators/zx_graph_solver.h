@@ -0,0 +1,70 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STIM_ZX_GRAPH_SOLVER_H
+#define STIM_ZX_GRAPH_SOLVER_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../stabilizers/pauli_string.h"
+
+namespace stim_internal {
+
+enum ZxNodeKind : uint8_t {
+    ZX_NODE_X = 0,
+    ZX_NODE_Z = 1,
+    ZX_NODE_H = 2,
+    ZX_NODE_IN = 3,
+    ZX_NODE_OUT = 4,
+};
+
+struct ZxNode {
+    ZxNodeKind kind;
+    /// The spider's angle, in multiples of pi/2. Only used by X and Z nodes.
+    uint8_t quarter_turns;
+};
+
+/// Computes the stabilizers of the state made by turning every input and output leg of a ZX graph into an output.
+///
+/// Each edge is interpreted as a cup producing an EPR pair, and each spider as a family of postselected parity
+/// measurements over the qubits of its incident edges. The postselections are done by collapsing the measured qubits
+/// directly onto the desired result, so all the postselections of a spider share one transpose of the tableau.
+///
+/// Qubits are only allocated for an edge when the first of its endpoints is processed, and the qubits of an edge are
+/// recycled once both of its endpoints have been processed. Nodes are processed in index order, so the size of the
+/// simulated state is the largest number of edges crossing between processed and unprocessed nodes. Numbering the
+/// nodes so that neighbors have nearby indices (e.g. in reading order of a diagram) keeps this small.
+///
+/// Args:
+///     nodes: The kinds of the graph's nodes (and angles of its spiders), indexed by node id.
+///     edges: The pairs of node ids connected by each edge. Self edges are ignored, and repeated edges cancel out in
+///         pairs.
+///
+/// Returns:
+///     Canonical stabilizer generators of the state. Qubit k of each stabilizer corresponds to the k'th input node
+///     by node id, followed by the output nodes by node id.
+///
+/// Throws:
+///     std::invalid_argument: A node id is out of range, an input or output node doesn't have exactly one neighbor,
+///         a Hadamard node doesn't have exactly two neighbors, or the graph contains a contradiction.
+std::vector<PauliString> zx_graph_dual_stabilizers(
+    const std::vector<ZxNode> &nodes, const std::vector<std::pair<size_t, size_t>> &edges);
+
+}  // namespace stim_internal
+
+#endif
@@ -0,0 +1,53 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "zx_graph_solver.h"
+
+#include "../benchmark_util.h"
+
+using namespace stim_internal;
+
+BENCHMARK(zx_graph_dual_stabilizers_cnot_ladder_10K_nodes) {
+    // A ladder of CNOTs between two wires, numbered in diagram reading order so the frontier stays small.
+    size_t num_rungs = 5000;
+    std::vector<ZxNode> nodes{{ZX_NODE_IN, 0}, {ZX_NODE_IN, 0}};
+    std::vector<std::pair<size_t, size_t>> edges;
+    size_t prev_a = 0;
+    size_t prev_b = 1;
+    for (size_t k = 0; k < num_rungs; k++) {
+        size_t a = nodes.size();
+        size_t b = a + 1;
+        nodes.push_back({k & 1 ? ZX_NODE_X : ZX_NODE_Z, 0});
+        nodes.push_back({k & 1 ? ZX_NODE_Z : ZX_NODE_X, 0});
+        edges.push_back({prev_a, a});
+        edges.push_back({prev_b, b});
+        edges.push_back({a, b});
+        prev_a = a;
+        prev_b = b;
+    }
+    nodes.push_back({ZX_NODE_OUT, 0});
+    nodes.push_back({ZX_NODE_OUT, 0});
+    edges.push_back({prev_a, nodes.size() - 2});
+    edges.push_back({prev_b, nodes.size() - 1});
+
+    size_t total = 0;
+    benchmark_go([&]() {
+        total += zx_graph_dual_stabilizers(nodes, edges).size();
+    })
+        .goal_millis(400)
+        .show_rate("Nodes", nodes.size());
+    if (total == 0) {
+        std::cout << "data dependence";
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "zx_graph_solver.pybind.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "../py/base.pybind.h"
+#include "../simulators/zx_graph_solver.h"
+#include "../stabilizers/pauli_string.pybind.h"
+
+using namespace stim_internal;
+
+std::vector<PyPauliString> py_zx_graph_dual_stabilizers(
+    const pybind11::array_t<uint8_t, pybind11::array::c_style | pybind11::array::forcecast> &node_kinds,
+    const pybind11::array_t<uint8_t, pybind11::array::c_style | pybind11::array::forcecast> &node_quarter_turns,
+    const pybind11::array_t<uint64_t, pybind11::array::c_style | pybind11::array::forcecast> &edges) {
+    if (node_kinds.ndim() != 1 || node_quarter_turns.ndim() != 1 || node_kinds.size() != node_quarter_turns.size()) {
+        throw std::invalid_argument("node_kinds and node_quarter_turns must be 1d arrays with the same length.");
+    }
+    if (edges.size() != 0 && (edges.ndim() != 2 || edges.shape(1) != 2)) {
+        throw std::invalid_argument("edges must be a 2d array with shape (num_edges, 2).");
+    }
+
+    std::vector<ZxNode> nodes;
+    nodes.reserve(node_kinds.size());
+    auto kinds = node_kinds.unchecked<1>();
+    auto quarter_turns = node_quarter_turns.unchecked<1>();
+    for (ssize_t k = 0; k < kinds.shape(0); k++) {
+        nodes.push_back({(ZxNodeKind)kinds(k), quarter_turns(k)});
+    }
+
+    std::vector<std::pair<size_t, size_t>> edge_list;
+    if (edges.size() != 0) {
+        edge_list.reserve(edges.shape(0));
+        auto e = edges.unchecked<2>();
+        for (ssize_t k = 0; k < e.shape(0); k++) {
+            edge_list.push_back({(size_t)e(k, 0), (size_t)e(k, 1)});
+        }
+    }
+
+    std::vector<PyPauliString> result;
+    for (auto &s : zx_graph_dual_stabilizers(nodes, edge_list)) {
+        result.emplace_back(std::move(s), false);
+    }
+    return result;
+}
+
+void pybind_zx_graph_solver(pybind11::module &m) {
+    m.def(
+        "zx_graph_dual_stabilizers",
+        &py_zx_graph_dual_stabilizers,
+        pybind11::arg("node_kinds"),
+        pybind11::arg("node_quarter_turns"),
+        pybind11::arg("edges"),
+        clean_doc_string(u8R"DOC(
+            Computes the stabilizers of the state made by turning every input and output of a ZX graph into an output.
+
+            Each edge is interpreted as an EPR pair, and each spider as a family of postselected parity measurements
+            over the qubits of its edges. Nodes are processed in order, and the qubits of an edge are recycled as
+            soon as both of its nodes have been processed, so numbering the nodes so that neighbors have nearby ids
+            (e.g. in reading order of a diagram) keeps the simulated state small.
+
+            Self edges are ignored, and repeated edges cancel out in pairs.
+
+            Args:
+                node_kinds: A uint8 array with an entry for each node. The entry is 0 for an X spider, 1 for a Z
+                    spider, 2 for a Hadamard node (which must have exactly two neighbors), 3 for an input node, and 4
+                    for an output node. Input and output nodes must have exactly one neighbor.
+                node_quarter_turns: A uint8 array with an entry for each node. The entry is the angle of the spider,
+                    in multiples of pi/2. Ignored for nodes that aren't spiders.
+                edges: An integer array with shape (num_edges, 2). Each row is the pair of node ids connected by an
+                    edge.
+
+            Returns:
+                A list of canonical stabilizer generators of the state (see
+                `stim.TableauSimulator.canonical_stabilizers`). Qubit k of the stabilizers is the k'th input node by
+                node id, followed by the output nodes by node id.
+
+            Raises:
+                ValueError: The graph is malformed or contains a contradiction.
+
+            Examples:
+                >>> import stim
+                >>> # in---Z---out
+                >>> stim.zx_graph_dual_stabilizers(
+                ...     node_kinds=[3, 1, 4],
+                ...     node_quarter_turns=[0, 0, 0],
+                ...     edges=[(0, 1), (1, 2)],
+                ... )
+                [stim.PauliString("+XX"), stim.PauliString("+ZZ")]
+        )DOC")
+            .data());
+}
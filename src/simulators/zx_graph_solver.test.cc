@@ -0,0 +1,142 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "zx_graph_solver.h"
+
+#include <gtest/gtest.h>
+
+#include "../test_util.test.h"
+#include "tableau_simulator.h"
+
+using namespace stim_internal;
+
+static ZxNode node(ZxNodeKind kind, uint8_t quarter_turns = 0) {
+    return {kind, quarter_turns};
+}
+
+/// Canonical stabilizers of the state made by applying a circuit to the second half of a set of EPR pairs.
+static std::vector<PauliString> choi_stabilizers(size_t num_qubits, const char *circuit) {
+    std::mt19937_64 rng(0);
+    TableauSimulator sim(rng, 2 * num_qubits);
+    for (uint32_t k = 0; k < num_qubits; k++) {
+        GateTarget t[]{GateTarget{k}, GateTarget{(uint32_t)(k + num_qubits)}};
+        sim.H_XZ({{}, {&t[0]}});
+        sim.ZCX({{}, {&t[0], &t[2]}});
+    }
+    Circuit c(circuit);
+    c.for_each_operation([&](const Operation &op) {
+        std::vector<GateTarget> shifted;
+        for (auto t : op.target_data.targets) {
+            shifted.push_back(GateTarget{t.data + (uint32_t)num_qubits});
+        }
+        (sim.*op.gate->tableau_simulator_function)({op.target_data.args, shifted});
+    });
+    return sim.canonical_stabilizers();
+}
+
+TEST(zx_graph_solver, identity) {
+    // in---X---Z---out
+    auto actual = zx_graph_dual_stabilizers(
+        {node(ZX_NODE_IN), node(ZX_NODE_X), node(ZX_NODE_Z), node(ZX_NODE_OUT)}, {{0, 1}, {1, 2}, {2, 3}});
+    ASSERT_EQ(actual, choi_stabilizers(1, "I 0"));
+}
+
+TEST(zx_graph_solver, cnot) {
+    // in---X---out
+    //      |
+    // in---Z---out
+    auto actual = zx_graph_dual_stabilizers(
+        {node(ZX_NODE_IN),
+         node(ZX_NODE_X),
+         node(ZX_NODE_OUT),
+         node(ZX_NODE_IN),
+         node(ZX_NODE_Z),
+         node(ZX_NODE_OUT)},
+        {{0, 1}, {1, 2}, {1, 4}, {3, 4}, {4, 5}});
+    ASSERT_EQ(actual, choi_stabilizers(2, "CNOT 1 0"));
+}
+
+TEST(zx_graph_solver, cz) {
+    // in---Z---out
+    //      |
+    //      H
+    //      |
+    // in---Z---out
+    auto actual = zx_graph_dual_stabilizers(
+        {node(ZX_NODE_IN),
+         node(ZX_NODE_Z),
+         node(ZX_NODE_OUT),
+         node(ZX_NODE_H),
+         node(ZX_NODE_IN),
+         node(ZX_NODE_Z),
+         node(ZX_NODE_OUT)},
+        {{0, 1}, {1, 2}, {1, 3}, {3, 5}, {4, 5}, {5, 6}});
+    ASSERT_EQ(actual, choi_stabilizers(2, "CZ 0 1"));
+}
+
+TEST(zx_graph_solver, phases) {
+    auto phase = [](ZxNodeKind kind, uint8_t quarter_turns) {
+        return zx_graph_dual_stabilizers(
+            {node(ZX_NODE_IN), node(kind, quarter_turns), node(ZX_NODE_OUT)}, {{0, 1}, {1, 2}});
+    };
+    ASSERT_EQ(phase(ZX_NODE_Z, 1), choi_stabilizers(1, "S 0"));
+    ASSERT_EQ(phase(ZX_NODE_Z, 2), choi_stabilizers(1, "Z 0"));
+    ASSERT_EQ(phase(ZX_NODE_Z, 3), choi_stabilizers(1, "S_DAG 0"));
+    ASSERT_EQ(phase(ZX_NODE_X, 1), choi_stabilizers(1, "SQRT_X 0"));
+    ASSERT_EQ(phase(ZX_NODE_X, 2), choi_stabilizers(1, "X 0"));
+    ASSERT_EQ(phase(ZX_NODE_X, 3), choi_stabilizers(1, "SQRT_X_DAG 0"));
+    ASSERT_EQ(phase(ZX_NODE_H, 0), choi_stabilizers(1, "H 0"));
+}
+
+TEST(zx_graph_solver, repeated_and_self_edges) {
+    // in---Z---X---out, with the Z-X edge doubled (so it cancels) and a self edge on the Z node.
+    auto actual = zx_graph_dual_stabilizers(
+        {node(ZX_NODE_IN), node(ZX_NODE_Z), node(ZX_NODE_X), node(ZX_NODE_OUT)},
+        {{0, 1}, {1, 2}, {2, 1}, {1, 1}, {2, 3}});
+    ASSERT_EQ(actual, (std::vector<PauliString>{PauliString::from_str("X_"), PauliString::from_str("_Z")}));
+}
+
+TEST(zx_graph_solver, long_chain_matches_identity) {
+    // A long chain of alternating phase gates that multiplies out to the identity, to exercise qubit recycling.
+    std::vector<ZxNode> nodes{node(ZX_NODE_IN)};
+    std::vector<std::pair<size_t, size_t>> edges;
+    for (size_t k = 0; k < 400; k++) {
+        nodes.push_back(node(k & 1 ? ZX_NODE_X : ZX_NODE_Z, 2));
+        edges.push_back({nodes.size() - 2, nodes.size() - 1});
+    }
+    nodes.push_back(node(ZX_NODE_OUT));
+    edges.push_back({nodes.size() - 2, nodes.size() - 1});
+    // 200 X gates and 200 Z gates, alternating, is 200 copies of XZ = -iY, which is the identity up to global phase.
+    ASSERT_EQ(zx_graph_dual_stabilizers(nodes, edges), choi_stabilizers(1, "I 0"));
+}
+
+TEST(zx_graph_solver, invalid) {
+    ASSERT_THROW(
+        { zx_graph_dual_stabilizers({node(ZX_NODE_IN), node(ZX_NODE_Z)}, {{0, 2}}); }, std::invalid_argument);
+    ASSERT_THROW(
+        { zx_graph_dual_stabilizers({node(ZX_NODE_IN), node(ZX_NODE_Z)}, {}); }, std::invalid_argument);
+    ASSERT_THROW(
+        {
+            zx_graph_dual_stabilizers(
+                {node(ZX_NODE_IN), node(ZX_NODE_H), node(ZX_NODE_OUT), node(ZX_NODE_OUT)},
+                {{0, 1}, {1, 2}, {1, 3}});
+        },
+        std::invalid_argument);
+
+    // Contradictions.
+    ASSERT_THROW({ zx_graph_dual_stabilizers({node(ZX_NODE_Z, 2)}, {}); }, std::invalid_argument);
+    ASSERT_THROW(
+        { zx_graph_dual_stabilizers({node(ZX_NODE_Z, 2), node(ZX_NODE_Z)}, {{0, 1}}); }, std::invalid_argument);
+    ASSERT_EQ(zx_graph_dual_stabilizers({node(ZX_NODE_X), node(ZX_NODE_Z)}, {{0, 1}}), std::vector<PauliString>{});
+}
@@ -0,0 +1,62 @@
+# Copyright 2021 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+import numpy as np
+import pytest
+import stim
+
+
+def test_identity():
+    # in---X---Z---out
+    actual = stim.zx_graph_dual_stabilizers(
+        node_kinds=np.array([3, 0, 1, 4], dtype=np.uint8),
+        node_quarter_turns=np.array([0, 0, 0, 0], dtype=np.uint8),
+        edges=np.array([[0, 1], [1, 2], [2, 3]], dtype=np.uint64),
+    )
+    assert actual == [stim.PauliString("XX"), stim.PauliString("ZZ")]
+
+
+def test_cnot():
+    # in---X---out
+    #      |
+    # in---Z---out
+    actual = stim.zx_graph_dual_stabilizers(
+        node_kinds=[3, 0, 4, 3, 1, 4],
+        node_quarter_turns=[0] * 6,
+        edges=[(0, 1), (1, 2), (1, 4), (3, 4), (4, 5)],
+    )
+    s = stim.TableauSimulator()
+    for k in range(2):
+        s.h(k)
+        s.cnot(k, k + 2)
+    s.cnot(3, 2)
+    assert actual == s.canonical_stabilizers()
+
+
+def test_no_edges():
+    assert stim.zx_graph_dual_stabilizers(node_kinds=[1], node_quarter_turns=[0], edges=[]) == []
+
+
+def test_invalid():
+    with pytest.raises(ValueError, match="contradiction"):
+        stim.zx_graph_dual_stabilizers(
+            node_kinds=[1, 1],
+            node_quarter_turns=[2, 0],
+            edges=[(0, 1)],
+        )
+    with pytest.raises(ValueError, match="exactly one neighbor"):
+        stim.zx_graph_dual_stabilizers(node_kinds=[3], node_quarter_turns=[0], edges=[])
+    with pytest.raises(ValueError, match="shape"):
+        stim.zx_graph_dual_stabilizers(node_kinds=[3, 4], node_quarter_turns=[0, 0], edges=[0, 1])
+    with pytest.raises(ValueError, match="same length"):
+        stim.zx_graph_dual_stabilizers(node_kinds=[3, 4], node_quarter_turns=[0], edges=[(0, 1)])
@@ -0,0 +1,139 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pauli_string_batch.h"
+
+#include <sstream>
+
+using namespace stim_internal;
+
+PauliStringBatch::PauliStringBatch(size_t num_strings, size_t num_qubits)
+    : num_strings(num_strings),
+      num_qubits(num_qubits),
+      signs(num_strings),
+      xs(num_strings, num_qubits),
+      zs(num_strings, num_qubits) {
+}
+
+PauliStringBatch PauliStringBatch::from_pauli_strings(const std::vector<PauliString> &pauli_strings) {
+    size_t num_qubits = 0;
+    for (const auto &p : pauli_strings) {
+        num_qubits = std::max(num_qubits, p.num_qubits);
+    }
+    PauliStringBatch result(pauli_strings.size(), num_qubits);
+    for (size_t k = 0; k < pauli_strings.size(); k++) {
+        const auto &p = pauli_strings[k];
+        result.signs[k] = p.sign;
+        result.xs[k].truncated_overwrite_from(p.xs, p.num_qubits);
+        result.zs[k].truncated_overwrite_from(p.zs, p.num_qubits);
+    }
+    return result;
+}
+
+PauliStringRef PauliStringBatch::operator[](size_t index) {
+    return PauliStringRef(num_qubits, signs[index], xs[index], zs[index]);
+}
+
+const PauliStringRef PauliStringBatch::operator[](size_t index) const {
+    // HACK: const correctness is temporarily removed, but immediately restored.
+    return const_cast<PauliStringBatch &>(*this)[index];
+}
+
+bool PauliStringBatch::operator==(const PauliStringBatch &other) const {
+    return num_strings == other.num_strings && num_qubits == other.num_qubits && signs == other.signs &&
+           xs == other.xs && zs == other.zs;
+}
+
+bool PauliStringBatch::operator!=(const PauliStringBatch &other) const {
+    return !(*this == other);
+}
+
+simd_bits PauliStringBatch::inplace_right_mul_returning_imag_mask(const PauliStringBatch &rhs) {
+    if (num_strings != rhs.num_strings || num_qubits != rhs.num_qubits) {
+        throw std::invalid_argument("Pauli string batches have different sizes.");
+    }
+    simd_bits imag(num_strings);
+    for (size_t k = 0; k < num_strings; k++) {
+        uint8_t log_i = (*this)[k].inplace_right_mul_returning_log_i_scalar(rhs[k]);
+        signs[k] ^= (log_i & 2) != 0;
+        imag[k] = log_i & 1;
+    }
+    return imag;
+}
+
+simd_bits PauliStringBatch::anticommuting_rows(const PauliStringBatch &other) const {
+    if (num_strings != other.num_strings || num_qubits != other.num_qubits) {
+        throw std::invalid_argument("Pauli string batches have different sizes.");
+    }
+    simd_bits result(num_strings);
+    for (size_t k = 0; k < num_strings; k++) {
+        result[k] = !(*this)[k].commutes(other[k]);
+    }
+    return result;
+}
+
+simd_bit_table PauliStringBatch::anticommutation_matrix(const PauliStringBatch &other) const {
+    simd_bit_table result(num_strings, other.num_strings);
+    simd_bit_table other_xs_t = other.xs.transposed();
+    simd_bit_table other_zs_t = other.zs.transposed();
+    size_t n = std::min(num_qubits, other.num_qubits);
+    size_t num_u64 = (n + 63) >> 6;
+    for (size_t row = 0; row < num_strings; row++) {
+        simd_bits_range_ref out = result[row];
+        const uint64_t *row_xs = xs[row].u64;
+        const uint64_t *row_zs = zs[row].u64;
+        for (size_t w = 0; w < num_u64; w++) {
+            uint64_t word_mask = w + 1 < num_u64 || (n & 63) == 0 ? ~uint64_t{0} : (uint64_t{1} << (n & 63)) - 1;
+            uint64_t x = row_xs[w] & word_mask;
+            uint64_t z = row_zs[w] & word_mask;
+            for (size_t b = 0; b < 64 && ((x | z) >> b); b++) {
+                size_t q = (w << 6) + b;
+                if ((x >> b) & 1) {
+                    out ^= other_zs_t[q];
+                }
+                if ((z >> b) & 1) {
+                    out ^= other_xs_t[q];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+PauliStringBatch PauliStringBatch::after(const Tableau &tableau) const {
+    if (tableau.num_qubits != num_qubits) {
+        throw std::invalid_argument("Tableau size doesn't match Pauli string batch size.");
+    }
+    PauliStringBatch result(num_strings, num_qubits);
+    for (size_t k = 0; k < num_strings; k++) {
+        result[k] = tableau((*this)[k]);
+    }
+    return result;
+}
+
+std::string PauliStringBatch::str() const {
+    std::stringstream ss;
+    ss << *this;
+    return ss.str();
+}
+
+std::ostream &stim_internal::operator<<(std::ostream &out, const PauliStringBatch &batch) {
+    for (size_t k = 0; k < batch.num_strings; k++) {
+        if (k) {
+            out << "\n";
+        }
+        out << batch[k];
+    }
+    return out;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2021 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STIM_PAULI_STRING_BATCH_H
+#define STIM_PAULI_STRING_BATCH_H
+
+#include <iostream>
+#include <vector>
+
+#include "../simd/simd_bit_table.h"
+#include "pauli_string.h"
+#include "tableau.h"
+
+namespace stim_internal {
+
+/// A list of Pauli strings over the same number of qubits, densely packed so they can be operated on in bulk.
+///
+/// The Paulis of the k'th Pauli string are in row k (the major index) of `xs` and `zs`, and its sign is bit k of
+/// `signs`. Bits past `num_qubits` in a row, and past `num_strings` in `signs`, are kept at zero.
+struct PauliStringBatch {
+    /// The number of Pauli strings in the batch.
+    size_t num_strings;
+    /// The length of each Pauli string.
+    size_t num_qubits;
+    /// Whether or not each Pauli string is negated.
+    simd_bits signs;
+    /// The xz-encoded Paulis of each Pauli string (see PauliString).
+    simd_bit_table xs, zs;
+
+    /// Creates a batch of identity Pauli strings.
+    PauliStringBatch(size_t num_strings, size_t num_qubits);
+    /// Factory method for creating a batch containing copies of the given Pauli strings.
+    ///
+    /// Shorter Pauli strings are padded with identities up to the length of the longest Pauli string.
+    static PauliStringBatch from_pauli_strings(const std::vector<PauliString> &pauli_strings);
+
+    /// Returns a reference to one of the Pauli strings in the batch.
+    PauliStringRef operator[](size_t index);
+    /// Returns a const reference to one of the Pauli strings in the batch.
+    const PauliStringRef operator[](size_t index) const;
+
+    /// Equality.
+    bool operator==(const PauliStringBatch &other) const;
+    /// Inequality.
+    bool operator!=(const PauliStringBatch &other) const;
+
+    /// Multiplies each Pauli string of the given batch into the corresponding Pauli string of this batch.
+    ///
+    /// Signs are updated for real scalar byproducts. Pauli strings that anticommute produce an imaginary byproduct,
+    /// which can't be stored, so instead the affected rows are reported.
+    ///
+    /// Returns:
+    ///     A bit mask of the rows whose product is missing a factor of i (in addition to the stored sign).
+    ///
+    /// Throws:
+    ///     std::invalid_argument: The batches have different sizes.
+    simd_bits inplace_right_mul_returning_imag_mask(const PauliStringBatch &rhs);
+
+    /// Determines, for each row, whether the Pauli string in this batch commutes with the one in the given batch.
+    ///
+    /// Returns:
+    ///     A bit mask with a 1 for each row where the Pauli strings anticommute.
+    ///
+    /// Throws:
+    ///     std::invalid_argument: The batches have different sizes.
+    simd_bits anticommuting_rows(const PauliStringBatch &other) const;
+
+    /// Determines which pairs of Pauli strings, one from this batch and one from the given batch, anticommute.
+    ///
+    /// Works one row of this batch at a time, xoring together the rows of the transposed other batch selected by the
+    /// row's non-identity terms. The cost is proportional to the number of non-identity terms in this batch times the
+    /// size of the other batch, which is much cheaper than comparing each pair when the Pauli strings are sparse.
+    ///
+    /// Returns:
+    ///     A table where bit (i, j) is set when this[i] anticommutes with other[j].
+    simd_bit_table anticommutation_matrix(const PauliStringBatch &other) const;
+
+    /// Returns the result of conjugating every Pauli string in the batch by the given tableau.
+    PauliStringBatch after(const Tableau &tableau) const;
+
+    /// Returns a string with one line per Pauli string.
+    std::string str() const;
+};
+
+/// Writes a string describing the given batch to an output stream.
+std::ostream &operator<<(std::ostream &out, const PauliStringBatch &batch);
+
+}  // namespace stim_internal
+
+#endif
@@ -0,0 +1,53 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pauli_string_batch.h"
+
+#include "../benchmark_util.h"
+
+using namespace stim_internal;
+
+/// A batch of Pauli strings with `weight` random non-identity terms each, like the stabilizers of a code.
+static PauliStringBatch sparse_batch(size_t num_strings, size_t num_qubits, size_t weight, std::mt19937_64 &rng) {
+    PauliStringBatch result(num_strings, num_qubits);
+    for (size_t k = 0; k < num_strings; k++) {
+        for (size_t w = 0; w < weight; w++) {
+            size_t q = rng() % num_qubits;
+            result.xs[k][q] = rng() & 1;
+            result.zs[k][q] = rng() & 1;
+        }
+    }
+    return result;
+}
+
+BENCHMARK(PauliStringBatch_multiplication_10Kstrings_1Kqubits) {
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    auto a = sparse_batch(10000, 1000, 1000, rng);
+    auto b = sparse_batch(10000, 1000, 1000, rng);
+    benchmark_go([&]() {
+        a.inplace_right_mul_returning_imag_mask(b);
+    })
+        .goal_micros(600)
+        .show_rate("Paulis", 10000 * 1000);
+}
+
+BENCHMARK(PauliStringBatch_anticommutation_matrix_10Kstrings_10Kqubits_weight6) {
+    std::mt19937_64 rng(0);  // NOLINT(cert-msc51-cpp)
+    auto a = sparse_batch(10000, 10000, 6, rng);
+    benchmark_go([&]() {
+        a.anticommutation_matrix(a);
+    })
+        .goal_millis(70)
+        .show_rate("Pairs", 10000 * 10000);
+}
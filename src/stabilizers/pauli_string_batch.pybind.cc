@@ -0,0 +1,387 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pauli_string_batch.pybind.h"
+
+#include "../py/base.pybind.h"
+#include "pauli_string.pybind.h"
+#include "pauli_string_batch.h"
+
+using namespace stim_internal;
+
+/// Returns a bit packed numpy view of the first `num_bits` bits of each row of a table, keeping `owner` alive.
+static pybind11::array_t<uint8_t> bit_packed_table_view(
+    simd_bit_table &table, size_t num_rows, size_t num_bits, const pybind11::object &owner) {
+    std::vector<ssize_t> shape{(ssize_t)num_rows, (ssize_t)((num_bits + 7) / 8)};
+    std::vector<ssize_t> stride{(ssize_t)table.num_simd_words_minor * (ssize_t)sizeof(simd_word), 1};
+    return pybind11::array_t<uint8_t>(shape, stride, table.data.u8, owner);
+}
+
+static pybind11::array_t<bool> bits_to_numpy(const simd_bits &bits, size_t num_bits) {
+    pybind11::array_t<bool> result((ssize_t)num_bits);
+    auto r = result.mutable_unchecked<1>();
+    for (size_t k = 0; k < num_bits; k++) {
+        r(k) = bits[k];
+    }
+    return result;
+}
+
+void pybind_pauli_string_batch(pybind11::module &m) {
+    auto &&c = pybind11::class_<PauliStringBatch>(
+        m,
+        "PauliStringBatch",
+        clean_doc_string(u8R"DOC(
+            A list of Pauli strings over the same number of qubits, densely packed so they can be operated on in bulk.
+
+            Operations on a batch (products, commutation checks, conjugation by a tableau) are done in C++ over all the
+            Pauli strings at once, instead of paying python interpreter overhead for each Pauli string. The bit packed
+            data backing the batch can be viewed as numpy arrays without copying.
+
+            Examples:
+                >>> import stim
+                >>> batch = stim.PauliStringBatch(["XX", "-ZZ", "Y_"])
+                >>> len(batch)
+                3
+                >>> batch[1]
+                stim.PauliString("-ZZ")
+                >>> print(batch)
+                +XX
+                -ZZ
+                +Y_
+                >>> batch.commutation_matrix(batch)
+                array([[ True,  True, False],
+                       [ True,  True, False],
+                       [False, False,  True]])
+        )DOC")
+            .data());
+
+    c.def(
+        pybind11::init([](const pybind11::iterable &pauli_strings) {
+            std::vector<PauliString> strings;
+            for (const auto &item : pauli_strings) {
+                if (pybind11::isinstance<pybind11::str>(item)) {
+                    strings.push_back(PauliString::from_str(pybind11::cast<std::string>(item).data()));
+                    continue;
+                }
+                const auto &p = pybind11::cast<const PyPauliString &>(item);
+                if (p.imag) {
+                    throw std::invalid_argument("Pauli strings in a batch can't have imaginary signs.");
+                }
+                strings.push_back(p.value);
+            }
+            return PauliStringBatch::from_pauli_strings(strings);
+        }),
+        pybind11::arg("pauli_strings"),
+        clean_doc_string(u8R"DOC(
+            Creates a batch containing copies of the given Pauli strings.
+
+            Shorter Pauli strings are padded with identity terms up to the length of the longest Pauli string.
+
+            Args:
+                pauli_strings: An iterable of `stim.PauliString`s or of texts like "-XYZ".
+
+            Raises:
+                ValueError: One of the Pauli strings has an imaginary sign.
+
+            Examples:
+                >>> import stim
+                >>> print(stim.PauliStringBatch([stim.PauliString("X"), "-_YZ"]))
+                +X__
+                -_YZ
+        )DOC")
+            .data());
+
+    c.def(
+        pybind11::init([](size_t num_strings, size_t num_qubits) {
+            return PauliStringBatch(num_strings, num_qubits);
+        }),
+        pybind11::arg("num_strings"),
+        pybind11::arg("num_qubits"),
+        clean_doc_string(u8R"DOC(
+            Creates a batch of identity Pauli strings.
+
+            Args:
+                num_strings: The number of Pauli strings in the batch.
+                num_qubits: The number of qubits each Pauli string acts on.
+
+            Examples:
+                >>> import stim
+                >>> print(stim.PauliStringBatch(2, 3))
+                +___
+                +___
+        )DOC")
+            .data());
+
+    c.def(
+        "__len__",
+        [](const PauliStringBatch &self) {
+            return self.num_strings;
+        },
+        clean_doc_string(u8R"DOC(
+            Returns the number of Pauli strings in the batch.
+        )DOC")
+            .data());
+
+    c.def_property_readonly(
+        "num_qubits",
+        [](const PauliStringBatch &self) {
+            return self.num_qubits;
+        },
+        clean_doc_string(u8R"DOC(
+            The number of qubits each Pauli string in the batch acts on.
+
+            Examples:
+                >>> import stim
+                >>> stim.PauliStringBatch(["X", "_Z"]).num_qubits
+                2
+        )DOC")
+            .data());
+
+    c.def(
+        "__getitem__",
+        [](const PauliStringBatch &self, pybind11::ssize_t index) {
+            if (index < 0) {
+                index += self.num_strings;
+            }
+            if (index < 0 || (size_t)index >= self.num_strings) {
+                throw std::out_of_range("index");
+            }
+            return PyPauliString(self[(size_t)index]);
+        },
+        pybind11::arg("index"),
+        clean_doc_string(u8R"DOC(
+            Returns a copy of one of the Pauli strings in the batch.
+
+            Args:
+                index: The index of the Pauli string to return. Negative indices are relative to the end of the batch.
+
+            Examples:
+                >>> import stim
+                >>> batch = stim.PauliStringBatch(["X_", "-_Z"])
+                >>> batch[0]
+                stim.PauliString("+X_")
+                >>> batch[-1]
+                stim.PauliString("-_Z")
+        )DOC")
+            .data());
+
+    c.def(pybind11::self == pybind11::self, "Determines if two Pauli string batches have identical contents.");
+    c.def(pybind11::self != pybind11::self, "Determines if two Pauli string batches have non-identical contents.");
+
+    c.def("__str__", &PauliStringBatch::str, "Returns a text description, with one line per Pauli string.");
+
+    c.def(
+        "__repr__",
+        [](const PauliStringBatch &self) {
+            std::string result = "stim.PauliStringBatch([";
+            for (size_t k = 0; k < self.num_strings; k++) {
+                if (k) {
+                    result += ", ";
+                }
+                result += "\"" + self[k].str() + "\"";
+            }
+            result += "])";
+            return result;
+        },
+        "Returns text that is a valid python expression evaluating to an equivalent `stim.PauliStringBatch`.");
+
+    c.def(
+        "__mul__",
+        [](const PauliStringBatch &self, const PauliStringBatch &rhs) {
+            PauliStringBatch result = self;
+            if (result.inplace_right_mul_returning_imag_mask(rhs).not_zero()) {
+                throw std::invalid_argument(
+                    "Some of the multiplied Pauli strings anticommute, so their products have imaginary signs.");
+            }
+            return result;
+        },
+        pybind11::is_operator(),
+        pybind11::arg("rhs"),
+        clean_doc_string(u8R"DOC(
+            Returns the element-wise product of two batches of Pauli strings.
+
+            Args:
+                rhs: The right hand side of the multiplication. Must have the same size as the left hand side.
+
+            Returns:
+                A batch where the k'th Pauli string is the product of the k'th Pauli strings of the two batches.
+
+            Raises:
+                ValueError: The batches have different sizes, or some of the multiplied Pauli strings anticommute.
+
+            Examples:
+                >>> import stim
+                >>> a = stim.PauliStringBatch(["XX", "Z_"])
+                >>> b = stim.PauliStringBatch(["ZZ", "-Z_"])
+                >>> print(a * b)
+                -YY
+                -__
+        )DOC")
+            .data());
+
+    c.def(
+        "commutes",
+        [](const PauliStringBatch &self, const PauliStringBatch &other) {
+            simd_bits commutes = self.anticommuting_rows(other);
+            commutes.invert_bits();
+            return bits_to_numpy(commutes, self.num_strings);
+        },
+        pybind11::arg("other"),
+        clean_doc_string(u8R"DOC(
+            Determines, element-wise, whether the Pauli strings of two batches commute.
+
+            Args:
+                other: The other batch. Must have the same size as this batch.
+
+            Returns:
+                A `numpy.ndarray[bool]` where the k'th entry is whether the k'th Pauli strings of the two batches
+                commute.
+
+            Examples:
+                >>> import stim
+                >>> a = stim.PauliStringBatch(["XX", "X_"])
+                >>> a.commutes(stim.PauliStringBatch(["ZZ", "Z_"]))
+                array([ True, False])
+        )DOC")
+            .data());
+
+    c.def(
+        "commutation_matrix",
+        [](const PauliStringBatch &self, const PauliStringBatch &other) {
+            simd_bit_table anticommutes = self.anticommutation_matrix(other);
+            pybind11::array_t<bool> result({(ssize_t)self.num_strings, (ssize_t)other.num_strings});
+            auto r = result.mutable_unchecked<2>();
+            for (size_t i = 0; i < self.num_strings; i++) {
+                for (size_t j = 0; j < other.num_strings; j++) {
+                    r(i, j) = !anticommutes[i][j];
+                }
+            }
+            return result;
+        },
+        pybind11::arg("other"),
+        clean_doc_string(u8R"DOC(
+            Determines whether each Pauli string in this batch commutes with each Pauli string in another batch.
+
+            Runs in time proportional to the number of non-identity terms in this batch times the size of the other
+            batch, so sparse Pauli strings (e.g. the stabilizers of a code) should be put on the left hand side.
+
+            Args:
+                other: The other batch. Shorter Pauli strings are treated as padded with identity terms.
+
+            Returns:
+                A `numpy.ndarray[bool]` with shape `(len(self), len(other))`, where entry `[i, j]` is whether `self[i]`
+                commutes with `other[j]`.
+
+            Examples:
+                >>> import stim
+                >>> a = stim.PauliStringBatch(["XX", "Z_"])
+                >>> a.commutation_matrix(stim.PauliStringBatch(["ZZ", "X_", "Y_"]))
+                array([[ True,  True, False],
+                       [ True, False, False]])
+        )DOC")
+            .data());
+
+    c.def(
+        "after",
+        &PauliStringBatch::after,
+        pybind11::arg("tableau"),
+        clean_doc_string(u8R"DOC(
+            Returns the result of conjugating every Pauli string in the batch by a Clifford operation.
+
+            Args:
+                tableau: A `stim.Tableau` describing the Clifford operation. Must act on the same number of qubits as
+                    the Pauli strings in the batch.
+
+            Returns:
+                A batch where the k'th Pauli string is `tableau(self[k])`.
+
+            Examples:
+                >>> import stim
+                >>> batch = stim.PauliStringBatch(["X_", "-Z_", "YZ"])
+                >>> print(batch.after(stim.Tableau.from_named_gate("CNOT")))
+                +XX
+                -Z_
+                +XY
+        )DOC")
+            .data());
+
+    c.def_property_readonly(
+        "xs",
+        [](pybind11::object self) {
+            auto &batch = pybind11::cast<PauliStringBatch &>(self);
+            return bit_packed_table_view(batch.xs, batch.num_strings, batch.num_qubits, self);
+        },
+        clean_doc_string(u8R"DOC(
+            A bit packed numpy view of the X bits of the Pauli strings in the batch (no data is copied).
+
+            The view is a `numpy.ndarray[uint8]` with shape `(len(self), (self.num_qubits + 7) // 8)`. Bit `q % 8` of
+            byte `[k, q // 8]` is set when the k'th Pauli string has an X or Y term on qubit q. Writing into the view
+            modifies the batch. Bits past `num_qubits` must be left at zero.
+
+            Examples:
+                >>> import stim
+                >>> batch = stim.PauliStringBatch(["XX", "-ZZ", "Y_"])
+                >>> batch.xs
+                array([[3],
+                       [0],
+                       [1]], dtype=uint8)
+        )DOC")
+            .data());
+
+    c.def_property_readonly(
+        "zs",
+        [](pybind11::object self) {
+            auto &batch = pybind11::cast<PauliStringBatch &>(self);
+            return bit_packed_table_view(batch.zs, batch.num_strings, batch.num_qubits, self);
+        },
+        clean_doc_string(u8R"DOC(
+            A bit packed numpy view of the Z bits of the Pauli strings in the batch (no data is copied).
+
+            The view is a `numpy.ndarray[uint8]` with shape `(len(self), (self.num_qubits + 7) // 8)`. Bit `q % 8` of
+            byte `[k, q // 8]` is set when the k'th Pauli string has a Z or Y term on qubit q. Writing into the view
+            modifies the batch. Bits past `num_qubits` must be left at zero.
+
+            Examples:
+                >>> import stim
+                >>> batch = stim.PauliStringBatch(["XX", "-ZZ", "Y_"])
+                >>> batch.zs
+                array([[0],
+                       [3],
+                       [1]], dtype=uint8)
+        )DOC")
+            .data());
+
+    c.def_property_readonly(
+        "signs",
+        [](pybind11::object self) {
+            auto &batch = pybind11::cast<PauliStringBatch &>(self);
+            std::vector<ssize_t> shape{(ssize_t)((batch.num_strings + 7) / 8)};
+            std::vector<ssize_t> stride{1};
+            return pybind11::array_t<uint8_t>(shape, stride, batch.signs.u8, self);
+        },
+        clean_doc_string(u8R"DOC(
+            A bit packed numpy view of the signs of the Pauli strings in the batch (no data is copied).
+
+            The view is a `numpy.ndarray[uint8]` with shape `((len(self) + 7) // 8,)`. Bit `k % 8` of byte `k // 8` is
+            set when the k'th Pauli string is negated. Writing into the view modifies the batch. Bits past `len(self)`
+            must be left at zero.
+
+            Examples:
+                >>> import stim
+                >>> batch = stim.PauliStringBatch(["XX", "-ZZ", "Y_"])
+                >>> batch.signs
+                array([2], dtype=uint8)
+        )DOC")
+            .data());
+}
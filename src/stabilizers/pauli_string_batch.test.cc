@@ -0,0 +1,133 @@
+// Copyright 2021 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pauli_string_batch.h"
+
+#include <gtest/gtest.h>
+
+#include "../test_util.test.h"
+
+using namespace stim_internal;
+
+static PauliStringBatch batch(const std::vector<const char *> &texts) {
+    std::vector<PauliString> strings;
+    for (const auto *t : texts) {
+        strings.push_back(PauliString::from_str(t));
+    }
+    return PauliStringBatch::from_pauli_strings(strings);
+}
+
+TEST(pauli_string_batch, from_pauli_strings) {
+    auto b = batch({"XYZ", "-X", "_Z"});
+    ASSERT_EQ(b.num_strings, 3);
+    ASSERT_EQ(b.num_qubits, 3);
+    ASSERT_EQ(b.str(), "+XYZ\n-X__\n+_Z_");
+    ASSERT_EQ(b[1], PauliString::from_str("-X__"));
+    ASSERT_EQ(PauliStringBatch(2, 4).str(), "+____\n+____");
+    ASSERT_EQ(PauliStringBatch(0, 4).str(), "");
+
+    b[2].sign ^= true;
+    b[2].xs[0] = true;
+    ASSERT_EQ(b.str(), "+XYZ\n-X__\n-XZ_");
+    ASSERT_TRUE(b == batch({"XYZ", "-X", "-XZ"}));
+    ASSERT_TRUE(b != batch({"XYZ", "-X", "XZ"}));
+}
+
+TEST(pauli_string_batch, inplace_right_mul_returning_imag_mask) {
+    auto a = batch({"XX", "X_", "-Z_", "YY"});
+    auto b = batch({"ZZ", "Y_", "-X_", "-_Y"});
+    auto imag = a.inplace_right_mul_returning_imag_mask(b);
+    ASSERT_EQ(a.str(), "-YY\n+Z_\n+Y_\n-Y_");
+    ASSERT_FALSE(imag[0]);
+    ASSERT_TRUE(imag[1]);
+    ASSERT_TRUE(imag[2]);
+    ASSERT_FALSE(imag[3]);
+
+    auto c = batch({"XX"});
+    ASSERT_THROW({ c.inplace_right_mul_returning_imag_mask(b); }, std::invalid_argument);
+
+    std::mt19937_64 &rng = SHARED_TEST_RNG();
+    std::vector<PauliString> left;
+    std::vector<PauliString> right;
+    for (size_t k = 0; k < 50; k++) {
+        left.push_back(PauliString::random(300, rng));
+        right.push_back(PauliString::random(300, rng));
+    }
+    auto batch_left = PauliStringBatch::from_pauli_strings(left);
+    imag = batch_left.inplace_right_mul_returning_imag_mask(PauliStringBatch::from_pauli_strings(right));
+    for (size_t k = 0; k < 50; k++) {
+        uint8_t log_i = left[k].ref().inplace_right_mul_returning_log_i_scalar(right[k]);
+        left[k].sign ^= (log_i & 2) != 0;
+        ASSERT_EQ(batch_left[k], left[k]);
+        ASSERT_EQ(imag[k], (log_i & 1) != 0);
+    }
+}
+
+TEST(pauli_string_batch, anticommuting_rows) {
+    auto a = batch({"XX", "X_", "Z_", "YYY"});
+    auto b = batch({"ZZ", "Y_", "X_", "__X"});
+    auto r = a.anticommuting_rows(b);
+    ASSERT_FALSE(r[0]);
+    ASSERT_TRUE(r[1]);
+    ASSERT_TRUE(r[2]);
+    ASSERT_TRUE(r[3]);
+    ASSERT_THROW({ a.anticommuting_rows(batch({"X"})); }, std::invalid_argument);
+}
+
+TEST(pauli_string_batch, anticommutation_matrix) {
+    auto a = batch({"XX", "Z_", "_Y"});
+    auto b = batch({"ZZ", "X_", "YY", "Z", "___"});
+    auto m = a.anticommutation_matrix(b);
+    for (size_t i = 0; i < a.num_strings; i++) {
+        for (size_t j = 0; j < b.num_strings; j++) {
+            ASSERT_EQ(m[i][j], !a[i].commutes(b[j])) << i << "," << j;
+        }
+    }
+
+    std::mt19937_64 &rng = SHARED_TEST_RNG();
+    std::vector<PauliString> left;
+    std::vector<PauliString> right;
+    for (size_t k = 0; k < 70; k++) {
+        left.push_back(PauliString::random(130, rng));
+    }
+    for (size_t k = 0; k < 90; k++) {
+        right.push_back(PauliString::random(150, rng));
+    }
+    auto batch_left = PauliStringBatch::from_pauli_strings(left);
+    auto batch_right = PauliStringBatch::from_pauli_strings(right);
+    m = batch_left.anticommutation_matrix(batch_right);
+    for (size_t i = 0; i < left.size(); i++) {
+        for (size_t j = 0; j < right.size(); j++) {
+            ASSERT_EQ(m[i][j], !left[i].ref().commutes(right[j])) << i << "," << j;
+        }
+    }
+}
+
+TEST(pauli_string_batch, after) {
+    auto h = Tableau::gate1("+Z", "+X");
+    auto b = batch({"X", "-Y", "Z", "_"});
+    ASSERT_EQ(b.after(h), batch({"Z", "Y", "X", "_"}));
+    ASSERT_THROW({ b.after(Tableau(2)); }, std::invalid_argument);
+
+    std::mt19937_64 &rng = SHARED_TEST_RNG();
+    auto t = Tableau::random(20, rng);
+    std::vector<PauliString> strings;
+    for (size_t k = 0; k < 30; k++) {
+        strings.push_back(PauliString::random(20, rng));
+    }
+    auto result = PauliStringBatch::from_pauli_strings(strings).after(t);
+    for (size_t k = 0; k < strings.size(); k++) {
+        ASSERT_EQ(result[k], t(strings[k]));
+    }
+}
@@ -0,0 +1,117 @@
+# Copyright 2021 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import pytest
+import stim
+
+
+def test_init():
+    batch = stim.PauliStringBatch(["XX", stim.PauliString("-Z"), "___Y"])
+    assert len(batch) == 3
+    assert batch.num_qubits == 4
+    assert batch[0] == stim.PauliString("XX__")
+    assert batch[1] == stim.PauliString("-Z___")
+    assert batch[-1] == stim.PauliString("___Y")
+    with pytest.raises(IndexError):
+        _ = batch[3]
+    with pytest.raises(ValueError):
+        stim.PauliStringBatch([stim.PauliString("iX")])
+
+    empty = stim.PauliStringBatch(5, 7)
+    assert len(empty) == 5
+    assert empty.num_qubits == 7
+    assert all(p == stim.PauliString(7) for p in empty)
+
+    assert len(stim.PauliStringBatch([])) == 0
+
+
+def test_equality_and_repr():
+    a = stim.PauliStringBatch(["XX", "-ZZ"])
+    assert a == stim.PauliStringBatch(["XX", "-ZZ"])
+    assert a != stim.PauliStringBatch(["XX", "ZZ"])
+    assert a != stim.PauliStringBatch(["XX"])
+    assert eval(repr(a), {"stim": stim}) == a
+    assert str(a) == "+XX\n-ZZ"
+
+
+def test_mul_matches_pauli_string():
+    left = []
+    right = []
+    while len(left) < 100:
+        a = stim.PauliString.random(40)
+        b = stim.PauliString.random(40)
+        if a.commutes(b):
+            left.append(a)
+            right.append(b)
+    product = stim.PauliStringBatch(left) * stim.PauliStringBatch(right)
+    for k in range(100):
+        assert product[k] == left[k] * right[k]
+
+    with pytest.raises(ValueError, match="anticommute"):
+        stim.PauliStringBatch(["X"]) * stim.PauliStringBatch(["Z"])
+    with pytest.raises(ValueError):
+        stim.PauliStringBatch(["X"]) * stim.PauliStringBatch(["X", "X"])
+
+
+def test_commutes():
+    a = stim.PauliStringBatch(["XX", "X_", "Z_"])
+    b = stim.PauliStringBatch(["ZZ", "Z_", "Z_"])
+    np.testing.assert_array_equal(a.commutes(b), [True, False, True])
+
+
+def test_commutation_matrix_matches_pauli_string():
+    left = [stim.PauliString.random(30) for _ in range(20)]
+    right = [stim.PauliString.random(50) for _ in range(25)]
+    m = stim.PauliStringBatch(left).commutation_matrix(stim.PauliStringBatch(right))
+    assert m.shape == (20, 25)
+    assert m.dtype == np.bool_
+    for i in range(20):
+        for j in range(25):
+            assert m[i, j] == left[i].commutes(right[j])
+
+
+def test_after_matches_tableau_call():
+    t = stim.Tableau.random(10)
+    strings = [stim.PauliString.random(10) for _ in range(30)]
+    result = stim.PauliStringBatch(strings).after(t)
+    for k in range(30):
+        assert result[k] == t(strings[k])
+    with pytest.raises(ValueError):
+        stim.PauliStringBatch(strings).after(stim.Tableau(3))
+
+
+def test_numpy_views_share_memory():
+    batch = stim.PauliStringBatch(["X_Z", "-YY_"])
+    xs = batch.xs
+    zs = batch.zs
+    signs = batch.signs
+    assert xs.shape == (2, 1)
+    assert xs.dtype == np.uint8
+    np.testing.assert_array_equal(xs, [[0b001], [0b011]])
+    np.testing.assert_array_equal(zs, [[0b100], [0b011]])
+    np.testing.assert_array_equal(signs, [0b10])
+
+    xs[0, 0] = 0b100
+    signs[0] = 0b01
+    assert batch[0] == stim.PauliString("-__Y_")
+    assert batch[1] == stim.PauliString("+YY_")
+
+    # The views keep the batch alive.
+    view = stim.PauliStringBatch(["Z"]).zs
+    np.testing.assert_array_equal(view, [[1]])
+
+    big = stim.PauliStringBatch(["X" * 70, "Z" * 70])
+    assert big.xs.shape == (2, 9)
+    np.testing.assert_array_equal(np.unpackbits(big.xs, axis=1, bitorder='little')[:, :70], [[1] * 70, [0] * 70])
@@ -14,6 +14,7 @@
 
 #include "tableau.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -24,6 +25,7 @@
 #include <thread>
 
 #include "../circuit/gate_data.h"
+#include "../profiling.h"
 #include "pauli_string.h"
 #include "tableau_transposed_raii.h"
 
@@ -32,7 +34,7 @@ using namespace stim_internal;
 void Tableau::expand(size_t new_num_qubits) {
     // If the new qubits fit inside the padding, just extend into it.
     assert(new_num_qubits >= num_qubits);
-    if (new_num_qubits <= xs.xt.num_major_bits_padded()) {
+    if (new_num_qubits <= capacity()) {
         size_t old_num_qubits = num_qubits;
         num_qubits = new_num_qubits;
         xs.num_qubits = new_num_qubits;
@@ -44,33 +46,56 @@ void Tableau::expand(size_t new_num_qubits) {
         return;
     }
 
+    // Grow the capacity geometrically, so that adding qubits one at a time costs amortized O(n) per qubit instead of
+    // re-allocating and copying the whole O(n^2) tableau every time.
+    size_t new_capacity = std::max(new_num_qubits, capacity() * 2);
+
     // Move state to temporary storage then re-allocate to make room for additional qubits.
     size_t old_num_simd_words = xs.xt.num_simd_words_major;
     size_t old_num_qubits = num_qubits;
     Tableau old_state = std::move(*this);
     this->~Tableau();
-    new (this) Tableau(new_num_qubits);
+    new (this) Tableau(new_capacity);
+
+    // Shrink back to the requested size, leaving the rest as zeroed padding.
+    num_qubits = new_num_qubits;
+    xs.num_qubits = new_num_qubits;
+    zs.num_qubits = new_num_qubits;
+    for (size_t k = new_num_qubits; k < new_capacity; k++) {
+        xs.xt[k][k] = false;
+        zs.zt[k][k] = false;
+    }
 
     // Copy stored state back into new larger space.
     auto partial_copy = [=](simd_bits_range_ref dst, simd_bits_range_ref src) {
-        dst.word_range_ref(0, old_num_simd_words) = src;
+        dst.word_range_ref(0, old_num_simd_words) = src.word_range_ref(0, old_num_simd_words);
     };
     partial_copy(xs.signs, old_state.xs.signs);
     partial_copy(zs.signs, old_state.zs.signs);
     for (size_t k = 0; k < old_num_qubits; k++) {
-        partial_copy(xs[k].xs, old_state.xs[k].xs);
-        partial_copy(xs[k].zs, old_state.xs[k].zs);
-        partial_copy(zs[k].xs, old_state.zs[k].xs);
-        partial_copy(zs[k].zs, old_state.zs[k].zs);
+        partial_copy(xs.xt[k], old_state.xs.xt[k]);
+        partial_copy(xs.zt[k], old_state.xs.zt[k]);
+        partial_copy(zs.xt[k], old_state.zs.xt[k]);
+        partial_copy(zs.zt[k], old_state.zs.zt[k]);
     }
 }
 
+size_t Tableau::capacity() const {
+    return xs.xt.num_major_bits_padded();
+}
+
 PauliStringRef TableauHalf::operator[](size_t input_qubit) {
-    return PauliStringRef(num_qubits, signs[input_qubit], xt[input_qubit], zt[input_qubit]);
+    // Truncate the rows to the qubit count, so that they line up with pauli strings of the same size even when the
+    // table has extra capacity.
+    size_t n = simd_bits::min_bits_to_num_simd_words(num_qubits);
+    return PauliStringRef(
+        num_qubits, signs[input_qubit], xt[input_qubit].word_range_ref(0, n), zt[input_qubit].word_range_ref(0, n));
 }
 
 const PauliStringRef TableauHalf::operator[](size_t input_qubit) const {
-    return PauliStringRef(num_qubits, signs[input_qubit], xt[input_qubit], zt[input_qubit]);
+    size_t n = simd_bits::min_bits_to_num_simd_words(num_qubits);
+    return PauliStringRef(
+        num_qubits, signs[input_qubit], xt[input_qubit].word_range_ref(0, n), zt[input_qubit].word_range_ref(0, n));
 }
 
 PauliString Tableau::eval_y_obs(size_t qubit) const {
@@ -164,8 +189,16 @@ void Tableau::inplace_scatter_append(const Tableau &operation, const std::vector
 }
 
 bool Tableau::operator==(const Tableau &other) const {
-    return num_qubits == other.num_qubits && xs.xt == other.xs.xt && xs.zt == other.xs.zt && zs.xt == other.zs.xt &&
-           zs.zt == other.zs.zt && xs.signs == other.xs.signs && zs.signs == other.zs.signs;
+    // Compare row by row, so that differences in unused capacity don't matter.
+    if (num_qubits != other.num_qubits) {
+        return false;
+    }
+    for (size_t q = 0; q < num_qubits; q++) {
+        if (xs[q] != other.xs[q] || zs[q] != other.zs[q]) {
+            return false;
+        }
+    }
+    return true;
 }
 
 bool Tableau::operator!=(const Tableau &other) const {
@@ -381,7 +414,10 @@ bool Tableau::satisfies_invariants() const {
 }
 
 Tableau Tableau::inverse(bool skip_signs) const {
-    Tableau result(num_qubits);
+    // Copy to get tables with the same capacity, so the raw data can be moved around directly.
+    Tableau result = *this;
+    result.xs.signs.clear();
+    result.zs.signs.clear();
 
     // Transpose data with xx zz swap tweak.
     result.xs.xt.data = zs.zt.data;
@@ -410,7 +446,15 @@ Tableau Tableau::inverse(bool skip_signs) const {
 }
 
 void Tableau::do_transpose_quadrants() {
-    if (num_qubits >= 1024) {
+    ProfileScope profile_scope(GLOBAL_PROFILER.transposes);
+    profile_scope.add_bytes(xs.xt.data.num_u8_padded() * 8);
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // WebAssembly builds without pthreads support can't start threads.
+    bool use_threads = false;
+#else
+    bool use_threads = num_qubits >= 1024;
+#endif
+    if (use_threads) {
         std::thread t1([&]() {
             xs.xt.do_square_transpose();
         });
@@ -56,7 +56,13 @@ struct Tableau {
     PauliString eval_y_obs(size_t qubit) const;
 
     std::string str() const;
+    /// Grows the tableau to cover more qubits, acting as the identity on the new qubits.
+    ///
+    /// When the new qubits don't fit into the existing capacity, the capacity is at least doubled. This makes growing
+    /// a tableau one qubit at a time cost amortized O(n) per added qubit instead of O(n^2).
     void expand(size_t new_num_qubits);
+    /// The number of qubits the tableau can grow to before it has to re-allocate.
+    size_t capacity() const;
 
     /// Creates a Tableau representing the identity operation.
     static Tableau identity(size_t num_qubits);
@@ -54,6 +54,18 @@ BENCHMARK(tableau_random_1000) {
     }).goal_millis(200);
 }
 
+BENCHMARK(tableau_expand_one_qubit_at_a_time_to_5K) {
+    size_t n = 5000;
+    benchmark_go([&]() {
+        Tableau t(1);
+        for (size_t k = 2; k <= n; k++) {
+            t.expand(k);
+        }
+    })
+        .goal_millis(40)
+        .show_rate("Qubits", n);
+}
+
 BENCHMARK(tableau_cnot_10Kqubits) {
     size_t n = 10 * 1000;
     Tableau t(n);
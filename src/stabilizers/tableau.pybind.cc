@@ -14,6 +14,8 @@
 
 #include "tableau.pybind.h"
 
+#include <cstring>
+
 #include "../py/base.pybind.h"
 #include "../simulators/tableau_simulator.h"
 #include "../stabilizers/pauli_string.h"
@@ -22,6 +24,111 @@
 
 using namespace stim_internal;
 
+/// Copies the first `n` bits of the first `num_rows` rows of a table into a (optionally bit packed) numpy array.
+static pybind11::object table_to_numpy(const simd_bit_table &table, size_t num_rows, size_t n, bool bit_packed) {
+    if (bit_packed) {
+        size_t num_bytes = (n + 7) / 8;
+        pybind11::array_t<uint8_t> result({(ssize_t)num_rows, (ssize_t)num_bytes});
+        uint8_t *out = result.mutable_data();
+        for (size_t row = 0; row < num_rows; row++) {
+            memcpy(out + row * num_bytes, table[row].u8, num_bytes);
+        }
+        return std::move(result);
+    }
+
+    pybind11::array_t<bool> result({(ssize_t)num_rows, (ssize_t)n});
+    auto r = result.mutable_unchecked<2>();
+    for (size_t row = 0; row < num_rows; row++) {
+        auto bits = table[row];
+        for (size_t k = 0; k < n; k++) {
+            r(row, k) = bits[k];
+        }
+    }
+    return std::move(result);
+}
+
+/// Copies the first `n` bits of a bit vector into a (optionally bit packed) numpy array.
+static pybind11::object bits_to_numpy(const simd_bits &bits, size_t n, bool bit_packed) {
+    if (bit_packed) {
+        size_t num_bytes = (n + 7) / 8;
+        pybind11::array_t<uint8_t> result((ssize_t)num_bytes);
+        memcpy(result.mutable_data(), bits.u8, num_bytes);
+        return std::move(result);
+    }
+
+    pybind11::array_t<bool> result((ssize_t)n);
+    auto r = result.mutable_unchecked<1>();
+    for (size_t k = 0; k < n; k++) {
+        r(k) = bits[k];
+    }
+    return std::move(result);
+}
+
+/// Reads a numpy array of bits into the first `n` bits of `out`.
+///
+/// The array is either a bool array of length `n` or a bit packed uint8 array of length `ceil(n / 8)`. Bits past `n`
+/// in a bit packed array are ignored.
+static void numpy_to_bits(const pybind11::object &data, size_t n, simd_bits_range_ref out, const char *name) {
+    size_t num_bytes = (n + 7) / 8;
+    if (pybind11::isinstance<pybind11::array_t<bool>>(data)) {
+        auto arr = pybind11::cast<pybind11::array_t<bool>>(data);
+        if (arr.ndim() != 1 || (size_t)arr.shape(0) != n) {
+            throw std::invalid_argument(std::string(name) + " has the wrong shape.");
+        }
+        auto r = arr.unchecked<1>();
+        for (size_t k = 0; k < n; k++) {
+            out[k] = r(k);
+        }
+    } else if (pybind11::isinstance<pybind11::array_t<uint8_t>>(data)) {
+        auto arr = pybind11::cast<pybind11::array_t<uint8_t, pybind11::array::c_style>>(data);
+        if (arr.ndim() != 1 || (size_t)arr.shape(0) != num_bytes) {
+            throw std::invalid_argument(std::string(name) + " has the wrong shape.");
+        }
+        memcpy(out.u8, arr.data(), num_bytes);
+        for (size_t k = n; k < num_bytes * 8; k++) {
+            out[k] = false;
+        }
+    } else {
+        throw std::invalid_argument(
+            std::string(name) + " must be a numpy array with dtype bool or (if bit packed) dtype uint8.");
+    }
+}
+
+/// Reads a 2d numpy array of bits into the first `n` bits of the first `n` rows of `table`.
+///
+/// Each row is either `n` bools or (if bit packed) `ceil(n / 8)` uint8s. Bits past `n` in a bit packed row are ignored.
+static void numpy_to_table(const pybind11::object &data, size_t n, simd_bit_table &table, const char *name) {
+    size_t num_bytes = (n + 7) / 8;
+    if (pybind11::isinstance<pybind11::array_t<bool>>(data)) {
+        auto arr = pybind11::cast<pybind11::array_t<bool>>(data);
+        if (arr.ndim() != 2 || (size_t)arr.shape(0) != n || (size_t)arr.shape(1) != n) {
+            throw std::invalid_argument(std::string(name) + " has the wrong shape.");
+        }
+        auto r = arr.unchecked<2>();
+        for (size_t row = 0; row < n; row++) {
+            auto out = table[row];
+            for (size_t k = 0; k < n; k++) {
+                out[k] = r(row, k);
+            }
+        }
+    } else if (pybind11::isinstance<pybind11::array_t<uint8_t>>(data)) {
+        auto arr = pybind11::cast<pybind11::array_t<uint8_t, pybind11::array::c_style>>(data);
+        if (arr.ndim() != 2 || (size_t)arr.shape(0) != n || (size_t)arr.shape(1) != num_bytes) {
+            throw std::invalid_argument(std::string(name) + " has the wrong shape.");
+        }
+        for (size_t row = 0; row < n; row++) {
+            auto out = table[row];
+            memcpy(out.u8, arr.data() + row * num_bytes, num_bytes);
+            for (size_t k = n; k < num_bytes * 8; k++) {
+                out[k] = false;
+            }
+        }
+    } else {
+        throw std::invalid_argument(
+            std::string(name) + " must be a numpy array with dtype bool or (if bit packed) dtype uint8.");
+    }
+}
+
 void pybind_tableau(pybind11::module &m) {
     auto &&c = pybind11::class_<Tableau>(
         m,
@@ -929,6 +1036,139 @@ void pybind_tableau(pybind11::module &m) {
         )DOC")
             .data());
 
+    c.def(
+        "to_numpy",
+        [](const Tableau &self, bool bit_packed) {
+            size_t n = self.num_qubits;
+            return pybind11::make_tuple(
+                table_to_numpy(self.xs.xt, n, n, bit_packed),
+                table_to_numpy(self.xs.zt, n, n, bit_packed),
+                table_to_numpy(self.zs.xt, n, n, bit_packed),
+                table_to_numpy(self.zs.zt, n, n, bit_packed),
+                bits_to_numpy(self.xs.signs, n, bit_packed),
+                bits_to_numpy(self.zs.signs, n, bit_packed));
+        },
+        pybind11::kw_only(),
+        pybind11::arg("bit_packed") = false,
+        clean_doc_string(u8R"DOC(
+            Exports the tableau's quadrants and signs as numpy arrays.
+
+            Each quadrant is copied in bulk out of the tableau's internal bit tables, instead of being assembled from
+            one python call per entry. The bit packed form is a direct copy of the internal memory, with no per-bit
+            work, so it's the fastest way to get a large tableau into numpy.
+
+            Args:
+                bit_packed: Defaults to False. When False, the quadrants are `numpy.ndarray[bool]`s with shape
+                    `(n, n)` and the signs are `numpy.ndarray[bool]`s with shape `(n,)`. When True, each group of 8
+                    bits is packed into a uint8 (in little endian order, like `numpy.packbits(bitorder='little')`)
+                    so the quadrants have shape `(n, ceil(n / 8))` and the signs have shape `(ceil(n / 8),)`.
+
+            Returns:
+                An `(x2x, x2z, z2x, z2z, x_signs, z_signs)` tuple. Entry `[i, j]` of `x2x` is whether the output of
+                conjugating `X_i` has an X or Y term on qubit j. Similarly, `x2z` is about the Z or Y terms in the
+                outputs of the X inputs, and `z2x` and `z2z` are about the outputs of the Z inputs. Entry `i` of
+                `x_signs` (or `z_signs`) is whether the output of conjugating `X_i` (or `Z_i`) is negated.
+
+            Examples:
+                >>> import stim
+                >>> cnot = stim.Tableau.from_named_gate("CNOT")
+                >>> x2x, x2z, z2x, z2z, x_signs, z_signs = cnot.to_numpy()
+                >>> x2x
+                array([[ True,  True],
+                       [False,  True]])
+                >>> z2z
+                array([[ True, False],
+                       [ True,  True]])
+                >>> x_signs
+                array([False, False])
+
+                >>> stim.Tableau.from_named_gate("CNOT").to_numpy(bit_packed=True)[0]
+                array([[3],
+                       [2]], dtype=uint8)
+        )DOC")
+            .data());
+
+    c.def_static(
+        "from_numpy",
+        [](const pybind11::object &x2x,
+           const pybind11::object &x2z,
+           const pybind11::object &z2x,
+           const pybind11::object &z2z,
+           const pybind11::object &x_signs,
+           const pybind11::object &z_signs) {
+            size_t n = pybind11::len(x2x);
+            Tableau result(n);
+            numpy_to_table(x2x, n, result.xs.xt, "x2x");
+            numpy_to_table(x2z, n, result.xs.zt, "x2z");
+            numpy_to_table(z2x, n, result.zs.xt, "z2x");
+            numpy_to_table(z2z, n, result.zs.zt, "z2z");
+            if (!x_signs.is_none()) {
+                numpy_to_bits(x_signs, n, result.xs.signs, "x_signs");
+            }
+            if (!z_signs.is_none()) {
+                numpy_to_bits(z_signs, n, result.zs.signs, "z_signs");
+            }
+            if (!result.satisfies_invariants()) {
+                throw std::invalid_argument(
+                    "The given generator outputs don't describe a valid Clifford operation.\n"
+                    "They don't preserve commutativity.\n"
+                    "Everything must commute, except for X_k anticommuting with Z_k for each k.");
+            }
+            return result;
+        },
+        pybind11::kw_only(),
+        pybind11::arg("x2x"),
+        pybind11::arg("x2z"),
+        pybind11::arg("z2x"),
+        pybind11::arg("z2z"),
+        pybind11::arg("x_signs") = pybind11::none(),
+        pybind11::arg("z_signs") = pybind11::none(),
+        clean_doc_string(u8R"DOC(
+            Creates a tableau from numpy arrays describing its quadrants and signs.
+
+            The inverse of `stim.Tableau.to_numpy`. Each argument can be bit packed (dtype uint8) or not (dtype bool),
+            independently of the others. Verifies that the tableau is well formed.
+
+            Args:
+                x2x: Entry `[i, j]` is whether the output of conjugating `X_i` has an X or Y term on qubit j. A
+                    `numpy.ndarray[bool]` with shape `(n, n)` or a bit packed `numpy.ndarray[uint8]` with shape
+                    `(n, ceil(n / 8))`. The number of qubits `n` is taken from the length of this array.
+                x2z: Entry `[i, j]` is whether the output of conjugating `X_i` has a Z or Y term on qubit j.
+                z2x: Entry `[i, j]` is whether the output of conjugating `Z_i` has an X or Y term on qubit j.
+                z2z: Entry `[i, j]` is whether the output of conjugating `Z_i` has a Z or Y term on qubit j.
+                x_signs: Defaults to all False. Entry `i` is whether the output of conjugating `X_i` is negated.
+                    A `numpy.ndarray[bool]` with shape `(n,)` or a bit packed `numpy.ndarray[uint8]` with shape
+                    `(ceil(n / 8),)`.
+                z_signs: Defaults to all False. Entry `i` is whether the output of conjugating `Z_i` is negated.
+
+            Returns:
+                The created tableau.
+
+            Raises:
+                ValueError: The arrays have inconsistent shapes or unsupported dtypes, or they don't satisfy the
+                    required commutation relationships.
+
+            Examples:
+                >>> import stim
+                >>> import numpy as np
+                >>> t = stim.Tableau.from_numpy(
+                ...     x2x=np.array([[1, 1], [0, 1]], dtype=np.bool_),
+                ...     x2z=np.array([[0, 0], [0, 0]], dtype=np.bool_),
+                ...     z2x=np.array([[0, 0], [0, 0]], dtype=np.bool_),
+                ...     z2z=np.array([[1, 0], [1, 1]], dtype=np.bool_),
+                ... )
+                >>> t == stim.Tableau.from_named_gate("CNOT")
+                True
+
+                >>> t = stim.Tableau.random(10)
+                >>> x2x, x2z, z2x, z2z, x_signs, z_signs = t.to_numpy(bit_packed=True)
+                >>> t2 = stim.Tableau.from_numpy(
+                ...     x2x=x2x, x2z=x2z, z2x=z2x, z2z=z2z, x_signs=x_signs, z_signs=z_signs)
+                >>> t2 == t
+                True
+        )DOC")
+            .data());
+
     c.def(
         "__repr__",
         [](const Tableau &self) {
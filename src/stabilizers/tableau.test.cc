@@ -619,6 +619,52 @@ TEST(tableau, expand) {
     }
 }
 
+TEST(tableau, expand_grows_capacity_geometrically) {
+    Tableau t(1);
+    size_t num_reallocations = 0;
+    size_t prev_capacity = t.capacity();
+    for (size_t n = 2; n < 5000; n++) {
+        t.expand(n);
+        ASSERT_EQ(t.num_qubits, n);
+        ASSERT_GE(t.capacity(), n);
+        if (t.capacity() != prev_capacity) {
+            ASSERT_GE(t.capacity(), prev_capacity * 2);
+            prev_capacity = t.capacity();
+            num_reallocations++;
+        }
+    }
+    ASSERT_LE(num_reallocations, 5);
+    ASSERT_EQ(t, Tableau(4999));
+}
+
+TEST(tableau, extra_capacity_is_invisible) {
+    auto t = Tableau::random(300, SHARED_TEST_RNG());
+    auto t2 = Tableau::random(220, SHARED_TEST_RNG());
+    auto big = Tableau(2);
+    big.expand(257);
+    big.expand(520);
+    ASSERT_GT(big.capacity(), Tableau(520).capacity());
+    ASSERT_EQ(big, Tableau(520));
+
+    auto expanded = t;
+    expanded.expand(301);
+    expanded.expand(520);
+    ASSERT_GT(expanded.capacity(), Tableau(520).capacity());
+    ASSERT_EQ(expanded, t + Tableau(220));
+    ASSERT_EQ(expanded.inverse(), t.inverse() + Tableau(220));
+    ASSERT_EQ(expanded.then(t + t2), (t + Tableau(220)).then(t + t2));
+    ASSERT_TRUE(expanded.satisfies_invariants());
+
+    std::vector<size_t> targets;
+    for (size_t k = 300; k < 520; k++) {
+        targets.push_back(k);
+    }
+    expanded.inplace_scatter_prepend(t2, targets);
+    ASSERT_EQ(expanded, t + t2);
+    auto p = PauliString::random(520, SHARED_TEST_RNG());
+    ASSERT_EQ(expanded(p), (t + t2)(p));
+}
+
 TEST(tableau, transposed_access) {
     size_t n = 1000;
     Tableau t(n);
@@ -15,6 +15,7 @@ import re
 
 import stim
 import pytest
+import numpy as np
 
 
 def test_init_equality():
@@ -674,3 +675,63 @@ def test_inverse():
             stim.PauliString("+ZZ_"),
         ],
     )
+
+
+def test_to_numpy():
+    x2x, x2z, z2x, z2z, x_signs, z_signs = stim.Tableau.from_named_gate("CNOT").to_numpy()
+    np.testing.assert_array_equal(x2x, [[1, 1], [0, 1]])
+    np.testing.assert_array_equal(x2z, [[0, 0], [0, 0]])
+    np.testing.assert_array_equal(z2x, [[0, 0], [0, 0]])
+    np.testing.assert_array_equal(z2z, [[1, 0], [1, 1]])
+    np.testing.assert_array_equal(x_signs, [0, 0])
+    np.testing.assert_array_equal(z_signs, [0, 0])
+    assert x2x.dtype == np.bool_
+    assert x_signs.dtype == np.bool_
+
+    t = stim.Tableau.random(21)
+    x2x, x2z, z2x, z2z, x_signs, z_signs = t.to_numpy()
+    for i in range(21):
+        for j in range(21):
+            assert x2x[i, j] == (t.x_output_pauli(i, j) in [1, 2])
+            assert x2z[i, j] == (t.x_output_pauli(i, j) in [2, 3])
+            assert z2x[i, j] == (t.z_output_pauli(i, j) in [1, 2])
+            assert z2z[i, j] == (t.z_output_pauli(i, j) in [2, 3])
+        assert x_signs[i] == (t.x_output(i).sign == -1)
+        assert z_signs[i] == (t.z_output(i).sign == -1)
+
+    packed = t.to_numpy(bit_packed=True)
+    unpacked = t.to_numpy()
+    for p, u in zip(packed[:4], unpacked[:4]):
+        assert p.dtype == np.uint8
+        assert p.shape == (21, 3)
+        np.testing.assert_array_equal(np.unpackbits(p, axis=1, bitorder='little')[:, :21], u)
+    for p, u in zip(packed[4:], unpacked[4:]):
+        assert p.shape == (3,)
+        np.testing.assert_array_equal(np.unpackbits(p, bitorder='little')[:21], u)
+
+
+def test_from_numpy():
+    for n in [0, 1, 5, 8, 70]:
+        t = stim.Tableau.random(n)
+        x2x, x2z, z2x, z2z, x_signs, z_signs = t.to_numpy()
+        assert stim.Tableau.from_numpy(
+            x2x=x2x, x2z=x2z, z2x=z2x, z2z=z2z, x_signs=x_signs, z_signs=z_signs) == t
+        x2x, x2z, z2x, z2z, x_signs, z_signs = t.to_numpy(bit_packed=True)
+        assert stim.Tableau.from_numpy(
+            x2x=x2x, x2z=x2z, z2x=z2x, z2z=z2z, x_signs=x_signs, z_signs=z_signs) == t
+
+    z = np.zeros(shape=(2, 2), dtype=np.bool_)
+    e = np.eye(2, dtype=np.bool_)
+    assert stim.Tableau.from_numpy(x2x=e, x2z=z, z2x=z, z2z=e) == stim.Tableau(2)
+    assert stim.Tableau.from_numpy(
+        x2x=e, x2z=z, z2x=z, z2z=e, z_signs=np.array([0b10], dtype=np.uint8),
+    ) == stim.Tableau.from_conjugated_generators(
+        xs=[stim.PauliString("X_"), stim.PauliString("_X")],
+        zs=[stim.PauliString("Z_"), stim.PauliString("-_Z")],
+    )
+    with pytest.raises(ValueError, match="valid Clifford"):
+        stim.Tableau.from_numpy(x2x=e, x2z=z, z2x=z, z2z=z)
+    with pytest.raises(ValueError, match="wrong shape"):
+        stim.Tableau.from_numpy(x2x=e, x2z=z, z2x=z, z2z=np.eye(3, dtype=np.bool_))
+    with pytest.raises(ValueError, match="dtype"):
+        stim.Tableau.from_numpy(x2x=e, x2z=z, z2x=z, z2z=np.eye(2, dtype=np.float32))